@@ -0,0 +1,75 @@
+/* Request-per-thread simulation: every thread serves requests that each build a few short-lived deques (a work queue drained as
+ * it is filled, and result buffers), then drop them. Deque on operator new, on the thread-local block cache, and on a per-thread
+ * arena released after each request. */
+
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../src/ArenaDeque.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+const std::size_t repetitions = 3;
+
+template <typename Queue>
+uint64_t serve_request(std::mt19937& generator) {
+    uint64_t checksum = 0;
+    Queue work;
+    std::size_t items = 64 + generator() % 2048;
+    for (std::size_t i = 0; i < items; i++) {
+        work.push_back(static_cast<int>(i));
+        if (i % 3 == 0) {
+            checksum += static_cast<uint64_t>(work.front());
+            work.pop_front();
+        }
+    }
+
+    Queue results[4];
+    for (std::size_t i = 0; i < items; i++) results[i % 4].push_back(static_cast<int>(i * 7));
+    for (auto& result : results) checksum += static_cast<uint64_t>(result.back());
+    return checksum;
+}
+
+template <typename Queue, bool UseArena>
+double time_requests(std::size_t threads, std::size_t requests) {
+    return bench::measure_ns(repetitions, [&] {
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < threads; t++) {
+            workers.emplace_back([requests, t] {
+                std::mt19937 generator(static_cast<unsigned>(t));
+                DequeArena arena;
+                uint64_t checksum = 0;
+                for (std::size_t r = 0; r < requests; r++) {
+                    if (UseArena) {
+                        DequeArena::Scope scope(arena);
+                        checksum += serve_request<Queue>(generator);
+                        arena.release();
+                    } else {
+                        checksum += serve_request<Queue>(generator);
+                    }
+                }
+                bench::do_not_optimize(checksum);
+            });
+        }
+        for (auto& worker : workers) worker.join();
+    });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t requests = bench::size_argument(argc, argv, 20000);
+    std::size_t threads = std::max(2u, std::thread::hardware_concurrency());
+
+    double heap = time_requests<Deque<int, HeapBlockAllocator>, false>(threads, requests);
+    double cached = time_requests<Deque<int, CachedBlockAllocator>, false>(threads, requests);
+    double arena = time_requests<ArenaDeque<int>, true>(threads, requests);
+
+    double total = static_cast<double>(threads * requests);
+    std::printf("%-24s %8s %10s %12s %12s %12s\n", "ns/request", "threads", "requests", "heap", "cached", "arena");
+    std::printf("%-24s %8zu %10zu %12.1f %12.1f %12.1f\n", "5 deques per request", threads, requests, heap / total,
+                cached / total, arena / total);
+}
@@ -0,0 +1,84 @@
+/* Fixed 64-element blocks against adaptive block sizing: heap bytes per element of many small deques and of one large one,
+ * then push_back (including the repacks), a for_each_segment scan and an iterator scan over n ints. */
+
+#include <cstdint>
+#include <vector>
+
+#include "../src/Deque.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+const std::size_t repetitions = 5;
+
+double bytes_per_element(DequeBlockSizing sizing, std::size_t count, std::size_t size) {
+    std::vector<Deque<int>> deques;
+    std::size_t bytes = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        deques.emplace_back(sizing);
+        for (std::size_t j = 0; j < size; j++) deques.back().push_back(static_cast<int>(j));
+        bytes += deques.back().memory_usage().total();
+    }
+    return static_cast<double>(bytes) / (count * size);
+}
+
+Deque<int> filled(DequeBlockSizing sizing, std::size_t n) {
+    Deque<int> deque(sizing);
+    for (std::size_t i = 0; i < n; i++) deque.push_back(static_cast<int>(i));
+    return deque;
+}
+
+double iterate(const Deque<int>& deque) {
+    return bench::measure_ns(repetitions, [&] {
+        uint64_t sum = 0;
+        for (int value : deque) sum += static_cast<uint64_t>(value);
+        bench::do_not_optimize(sum);
+    });
+}
+
+double scan(const Deque<int>& deque) {
+    return bench::measure_ns(repetitions, [&] {
+        uint64_t sum = 0;
+        deque.for_each_segment([&sum](DequeSegment<const int*> segment) {
+            for (int value : segment) sum += static_cast<uint64_t>(value);
+        });
+        bench::do_not_optimize(sum);
+    });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t n = bench::size_argument(argc, argv, 1 << 24);
+
+    std::printf("%-24s %10s %12s %12s %9s\n", "operation", "n", "adaptive", "fixed", "ratio");
+    for (std::size_t size : {8, 40, 400}) {
+        double adaptive = bytes_per_element(DequeBlockSizing::adaptive, 10000, size);
+        double fixed = bytes_per_element(DequeBlockSizing::fixed, 10000, size);
+        std::printf("%-24s %10zu %12.2f %12.2f %8.2fx\n", "bytes/element, 10000x", size, adaptive, fixed, adaptive / fixed);
+    }
+
+    double push_adaptive = bench::measure_ns(repetitions, [&] {
+        bench::do_not_optimize(filled(DequeBlockSizing::adaptive, n).back());
+    });
+    double push_fixed = bench::measure_ns(repetitions, [&] {
+        bench::do_not_optimize(filled(DequeBlockSizing::fixed, n).back());
+    });
+    Deque<int> adaptive = filled(DequeBlockSizing::adaptive, n);
+    Deque<int> fixed = filled(DequeBlockSizing::fixed, n);
+    double scan_adaptive = scan(adaptive);
+    double scan_fixed = scan(fixed);
+    double iterate_adaptive = iterate(adaptive);
+    double iterate_fixed = iterate(fixed);
+
+    double adaptive_bytes = static_cast<double>(adaptive.memory_usage().total());
+    double fixed_bytes = static_cast<double>(fixed.memory_usage().total());
+    std::printf("%-24s %10zu %12.2f %12.2f %8.2fx\n", "bytes/element", n, adaptive_bytes / n, fixed_bytes / n,
+                adaptive_bytes / fixed_bytes);
+    std::printf("%-24s %10zu %12.2f %12.2f %8.2fx\n", "push_back ns", n, push_adaptive / n, push_fixed / n, push_adaptive / push_fixed);
+    std::printf("%-24s %10zu %12.2f %12.2f %8.2fx\n", "for_each_segment ns", n, scan_adaptive / n, scan_fixed / n,
+                scan_adaptive / scan_fixed);
+    std::printf("%-24s %10zu %12.2f %12.2f %8.2fx\n", "iterator ns", n, iterate_adaptive / n, iterate_fixed / n,
+                iterate_adaptive / iterate_fixed);
+    std::printf("(adaptive blocks end at %zu elements)\n", adaptive.block_size());
+}
@@ -0,0 +1,69 @@
+/* Sliding-window success rate over pass/fail flags: bit-packed Deque<bool> against std::deque<bool>. Every sample is pushed at
+ * the back and the oldest one popped once the window is full, and every `stride` samples the rate is recomputed from scratch
+ * with count() (std::count for std::deque). A last row compares the heap bytes per flag of a full window. */
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "../src/Deque.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+const std::size_t repetitions = 5;
+const std::size_t stride = 1024;
+
+std::vector<bool> make_samples(std::size_t n) {
+    std::mt19937 generator(66);
+    std::vector<bool> samples(n);
+    for (std::size_t i = 0; i < n; i++) samples[i] = generator() % 100 < 97;
+    return samples;
+}
+
+template <typename Flags, typename Count>
+double time_window(const std::vector<bool>& samples, std::size_t window, Count count) {
+    return bench::measure_ns(repetitions, [&] {
+        Flags flags;
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < samples.size(); i++) {
+            flags.push_back(samples[i]);
+            if (i >= window) {
+                flags.pop_front();
+            }
+            if (i % stride == 0) {
+                total += count(flags);
+            }
+        }
+        bench::do_not_optimize(total);
+    });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t window = bench::size_argument(argc, argv, 1 << 20);
+    std::vector<bool> samples = make_samples(4 * window);
+    std::size_t n = samples.size();
+
+    double mine = time_window<Deque<bool>>(samples, window, [](const Deque<bool>& flags) { return flags.count(); });
+    double stl = time_window<std::deque<bool>>(samples, window, [](const std::deque<bool>& flags) {
+        return static_cast<std::size_t>(std::count(flags.begin(), flags.end(), true));
+    });
+
+    bench::print_header();
+    bench::print_row("window push/pop/count", n, mine, stl);
+
+    Deque<bool> packed;
+    Deque<char> bytes;
+    for (std::size_t i = 0; i < window; i++) {
+        packed.push_back(samples[i]);
+        bytes.push_back(samples[i]);
+    }
+    std::printf("%-24s %10zu %12.3f %12.3f %8.2fx\n", "heap bytes per flag", window,
+                static_cast<double>(packed.memory_usage().total()) / window,
+                static_cast<double>(bytes.memory_usage().total()) / window,
+                static_cast<double>(packed.memory_usage().total()) / bytes.memory_usage().total());
+}
@@ -0,0 +1,37 @@
+/* Construct/fill/destroy churn of short-lived deques, the pattern of a service that builds a queue per request: Deque with the
+ * thread-local block cache, Deque straight on operator new, and std::deque. */
+
+#include <deque>
+
+#include "../src/Deque.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+const std::size_t repetitions = 5;
+
+template <typename Container>
+double time_churn(std::size_t deques, std::size_t elements) {
+    return bench::measure_ns(repetitions, [&] {
+        for (std::size_t i = 0; i < deques; i++) {
+            Container container;
+            for (std::size_t k = 0; k < elements; k++) container.push_back(static_cast<int>(k));
+            bench::do_not_optimize(container.back());
+        }
+    });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t deques = bench::size_argument(argc, argv, 100000);
+
+    std::printf("%-24s %10s %12s %12s %12s\n", "churn ns/deque", "elements", "cached", "heap", "std");
+    for (std::size_t elements : {0, 16, 200, 2000}) {
+        double cached = time_churn<Deque<int, CachedBlockAllocator>>(deques, elements);
+        double heap = time_churn<Deque<int, HeapBlockAllocator>>(deques, elements);
+        double stl = time_churn<std::deque<int>>(deques, elements);
+        std::printf("%-24s %10zu %12.1f %12.1f %12.1f\n", "construct+fill+destroy", elements, cached / deques, heap / deques,
+                    stl / deques);
+    }
+}
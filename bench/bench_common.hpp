@@ -0,0 +1,56 @@
+#ifndef BENCH_BENCH_COMMON_HPP_
+#define BENCH_BENCH_COMMON_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace bench {
+
+/* Keeps the optimizer from deleting the loop whose result nobody reads */
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/* Runs body() `repetitions` times and returns every run's time in nanoseconds, in run order */
+template <typename Body>
+std::vector<double> measure_samples(std::size_t repetitions, Body body) {
+    std::vector<double> samples;
+    samples.reserve(repetitions);
+
+    for (std::size_t i = 0; i < repetitions; i++) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto stop = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+    }
+
+    return samples;
+}
+
+/* Runs body() `repetitions` times and returns the fastest run in nanoseconds: the minimum is the least noisy
+ * estimator for short single-threaded kernels */
+template <typename Body>
+double measure_ns(std::size_t repetitions, Body body) {
+    std::vector<double> samples = measure_samples(repetitions, body);
+    return *std::min_element(samples.begin(), samples.end());
+}
+
+inline std::size_t size_argument(int argc, char** argv, std::size_t fallback) {
+    return argc > 1 ? std::strtoul(argv[1], nullptr, 10) : fallback;
+}
+
+inline void print_row(const char* name, std::size_t n, double mine_ns, double stl_ns) {
+    std::printf("%-24s %10zu %12.2f %12.2f %8.2fx\n", name, n, mine_ns / n, stl_ns / n, mine_ns / stl_ns);
+}
+
+inline void print_header() {
+    std::printf("%-24s %10s %12s %12s %9s\n", "operation", "n", "Deque ns/op", "std ns/op", "ratio");
+}
+
+}  // namespace bench
+
+#endif  // BENCH_BENCH_COMMON_HPP_
@@ -0,0 +1,56 @@
+/* Copying a Deque<int> out to a flat array: an operator[] loop, an iterator loop, copy_to (one memcpy per block) and
+ * parallel_copy_to (threaded past DEQUE_PARALLEL_COPY_BYTES per thread), against std::copy out of std::deque. */
+
+#include <algorithm>
+#include <deque>
+#include <thread>
+#include <vector>
+
+#include "../src/DequeParallel.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+const std::size_t repetitions = 7;
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t n = bench::size_argument(argc, argv, 1 << 22);
+
+    Deque<int> deque;
+    std::deque<int> model;
+    for (std::size_t i = 0; i < n; i++) {
+        deque.push_back(static_cast<int>(i));
+        model.push_back(static_cast<int>(i));
+    }
+    std::vector<int> flat(n);
+
+    double stl = bench::measure_ns(repetitions, [&] {
+        std::copy(model.begin(), model.end(), flat.begin());
+        bench::do_not_optimize(flat[n / 2]);
+    });
+    double indexed = bench::measure_ns(repetitions, [&] {
+        for (std::size_t i = 0; i < n; i++) flat[i] = deque[i];
+        bench::do_not_optimize(flat[n / 2]);
+    });
+    double iterated = bench::measure_ns(repetitions, [&] {
+        std::copy(deque.begin(), deque.end(), flat.begin());
+        bench::do_not_optimize(flat[n / 2]);
+    });
+    double blocks = bench::measure_ns(repetitions, [&] {
+        deque.copy_to(flat.data());
+        bench::do_not_optimize(flat[n / 2]);
+    });
+    double threaded = bench::measure_ns(repetitions, [&] {
+        parallel_copy_to(deque, flat.data());
+        bench::do_not_optimize(flat[n / 2]);
+    });
+
+    bench::print_header();
+    bench::print_row("operator[] loop", n, indexed, stl);
+    bench::print_row("iterator std::copy", n, iterated, stl);
+    bench::print_row("copy_to", n, blocks, stl);
+    bench::print_row("parallel_copy_to", n, threaded, stl);
+    std::printf("(%u hardware threads)\n", std::thread::hardware_concurrency());
+}
@@ -0,0 +1,118 @@
+/* BFS over a random graph: node-at-a-time std::deque, Frontier with batched pops and span pushes, and Frontier's parallel
+ * level-synchronous mode. */
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <random>
+#include <thread>
+
+#include "../src/Frontier.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+const std::size_t repetitions = 3;
+const uint32_t unreached = std::numeric_limits<uint32_t>::max();
+
+struct Graph {
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> targets;
+};
+
+Graph make_graph(uint32_t nodes, uint32_t degree) {
+    std::mt19937 generator(17);
+    Graph graph;
+    graph.offsets.push_back(0);
+    for (uint32_t node = 0; node < nodes; node++) {
+        for (uint32_t e = 0; e < degree; e++) graph.targets.push_back(generator() % nodes);
+        graph.offsets.push_back(static_cast<uint32_t>(graph.targets.size()));
+    }
+    return graph;
+}
+
+double time_std_deque(const Graph& graph) {
+    std::vector<uint32_t> distance(graph.offsets.size() - 1);
+    return bench::measure_ns(repetitions, [&] {
+        std::fill(distance.begin(), distance.end(), unreached);
+        std::deque<uint32_t> queue = {0};
+        distance[0] = 0;
+        while (!queue.empty()) {
+            uint32_t node = queue.front();
+            queue.pop_front();
+            for (uint32_t e = graph.offsets[node]; e < graph.offsets[node + 1]; e++) {
+                uint32_t target = graph.targets[e];
+                if (distance[target] == unreached) {
+                    distance[target] = distance[node] + 1;
+                    queue.push_back(target);
+                }
+            }
+        }
+    });
+}
+
+double time_frontier_batched(const Graph& graph) {
+    std::vector<uint32_t> distance(graph.offsets.size() - 1);
+    std::vector<uint32_t> batch(1024);
+    std::vector<uint32_t> discovered;
+    return bench::measure_ns(repetitions, [&] {
+        std::fill(distance.begin(), distance.end(), unreached);
+        Frontier<uint32_t> frontier;
+        frontier.push(0);
+        distance[0] = 0;
+        while (!frontier.empty()) {
+            std::size_t taken = frontier.pop_batch(batch.data(), batch.size());
+            discovered.clear();
+            for (std::size_t i = 0; i < taken; i++) {
+                uint32_t node = batch[i];
+                for (uint32_t e = graph.offsets[node]; e < graph.offsets[node + 1]; e++) {
+                    uint32_t target = graph.targets[e];
+                    if (distance[target] == unreached) {
+                        distance[target] = distance[node] + 1;
+                        discovered.push_back(target);
+                    }
+                }
+            }
+            frontier.push_span(discovered.data(), discovered.size());
+        }
+    });
+}
+
+double time_frontier_parallel(const Graph& graph, std::size_t threads) {
+    std::size_t nodes = graph.offsets.size() - 1;
+    std::unique_ptr<std::atomic<uint32_t>[]> distance(new std::atomic<uint32_t>[nodes]);
+    return bench::measure_ns(repetitions, [&] {
+        for (std::size_t node = 0; node < nodes; node++) distance[node].store(unreached, std::memory_order_relaxed);
+        Frontier<uint32_t> frontier;
+        frontier.push(0);
+        distance[0] = 0;
+        for (uint32_t level = 1; !frontier.empty(); level++) {
+            frontier.expand_level(threads, [&](uint32_t node, std::vector<uint32_t>& next) {
+                for (uint32_t e = graph.offsets[node]; e < graph.offsets[node + 1]; e++) {
+                    uint32_t target = graph.targets[e];
+                    uint32_t expected = unreached;
+                    if (distance[target].load(std::memory_order_relaxed) == unreached &&
+                        distance[target].compare_exchange_strong(expected, level, std::memory_order_relaxed)) {
+                        next.push_back(target);
+                    }
+                }
+            });
+        }
+    });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    uint32_t nodes = static_cast<uint32_t>(bench::size_argument(argc, argv, 2000000));
+    Graph graph = make_graph(nodes, 8);
+    std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::printf("%-28s %10s %12s\n", "bfs", "nodes", "ms");
+    std::printf("%-28s %10u %12.2f\n", "std::deque node-at-a-time", nodes, time_std_deque(graph) / 1e6);
+    std::printf("%-28s %10u %12.2f\n", "Frontier batched", nodes, time_frontier_batched(graph) / 1e6);
+    std::printf("%-28s %10u %12.2f\n", "Frontier parallel x1", nodes, time_frontier_parallel(graph, 1) / 1e6);
+    std::printf("Frontier parallel x%-9zu %10u %12.2f\n", threads, nodes, time_frontier_parallel(graph, threads) / 1e6);
+}
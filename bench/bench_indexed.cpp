@@ -0,0 +1,57 @@
+/* Range sums over a sliding deque: IndexedDeque::range_sum against rescanning the range of a plain Deque. Each step pushes one
+ * value at the back, pops one at the front and asks for the sum of a random range. */
+
+#include <cstdint>
+#include <random>
+
+#include "../src/IndexedDeque.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+const std::size_t repetitions = 3;
+const std::size_t queries = 2000;
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t n = bench::size_argument(argc, argv, 1000000);
+
+    std::mt19937 generator(9);
+    std::vector<std::pair<std::size_t, std::size_t>> ranges(queries);
+    for (auto& range : ranges) {
+        std::size_t a = generator() % n;
+        std::size_t b = generator() % n;
+        range = {std::min(a, b), std::max(a, b)};
+    }
+
+    IndexedDeque<int, int64_t> indexed;
+    Deque<int> plain;
+    for (std::size_t i = 0; i < n; i++) {
+        indexed.push_back(static_cast<int>(i % 1000));
+        plain.push_back(static_cast<int>(i % 1000));
+    }
+
+    double indexed_ns = bench::measure_ns(repetitions, [&] {
+        int64_t sum = 0;
+        for (auto& range : ranges) {
+            indexed.push_back(1);
+            indexed.pop_front();
+            sum += indexed.range_sum(range.first, range.second);
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    double rescan_ns = bench::measure_ns(repetitions, [&] {
+        int64_t sum = 0;
+        for (auto& range : ranges) {
+            plain.push_back(1);
+            plain.pop_front();
+            for (std::size_t i = range.first; i < range.second; i++) sum += plain[i];
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    std::printf("%-24s %10s %12s %12s %9s\n", "operation", "n", "Indexed", "rescan", "ratio");
+    bench::print_row("range_sum", queries, indexed_ns, rescan_ns);
+}
@@ -0,0 +1,108 @@
+/* Heap bytes per element against N and sizeof(T) for Deque, std::deque and std::vector.
+ * All three are measured with the same ruler: std::deque and std::vector through a counting allocator, Deque through a counting
+ * block policy, which sees its blocks and its map. The object header (sizeof the container) is included for all three. Deque
+ * rows also carry memory_usage().total() plus the header in the last column as a cross-check; it is empty for the others.
+ * Output is CSV, one row per (container, sizeof(T), N), meant to be fed to a plotting tool, e.g.
+ *   bench_memory > memory.csv
+ *   gnuplot -e "set datafile separator ','; set logscale x; plot 'memory.csv' using 3:5" */
+
+#include <cstdio>
+#include <deque>
+#include <vector>
+
+#include "../src/Deque.hpp"
+
+namespace {
+
+std::size_t allocated_bytes = 0;
+
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(std::size_t n) {
+        allocated_bytes += n * sizeof(T);
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        allocated_bytes -= n * sizeof(T);
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const CountingAllocator<U>&) const { return false; }
+};
+
+/*Deque's blocks and map come through here, counted on the same total as CountingAllocator*/
+struct CountingBlockAllocator {
+    static void* allocate(std::size_t bytes) {
+        allocated_bytes += bytes;
+        return ::operator new(bytes);
+    }
+
+    static void deallocate(void* storage, std::size_t bytes) noexcept {
+        allocated_bytes -= bytes;
+        ::operator delete(storage);
+    }
+};
+
+template <std::size_t Bytes>
+struct Payload {
+    char bytes[Bytes];
+};
+
+void print_row(const char* container, std::size_t element_size, std::size_t n, std::size_t bytes) {
+    std::printf("%s,%zu,%zu,%zu,%.2f,\n", container, element_size, n, bytes, static_cast<double>(bytes) / n);
+}
+
+void print_row(const char* container, std::size_t element_size, std::size_t n, std::size_t bytes, std::size_t reported) {
+    std::printf("%s,%zu,%zu,%zu,%.2f,%zu\n", container, element_size, n, bytes, static_cast<double>(bytes) / n, reported);
+}
+
+template <typename T>
+void measure(std::size_t n) {
+    T value{};
+
+    {
+        std::size_t before = allocated_bytes;
+        Deque<T, CountingBlockAllocator> deque;
+        for (std::size_t i = 0; i < n; i++) deque.push_back(value);
+        print_row("Deque", sizeof(T), n, sizeof(deque) + allocated_bytes - before, sizeof(deque) + deque.memory_usage().total());
+    }
+    {
+        std::size_t before = allocated_bytes;
+        std::deque<T, CountingAllocator<T>> deque;
+        for (std::size_t i = 0; i < n; i++) deque.push_back(value);
+        print_row("std::deque", sizeof(T), n, sizeof(deque) + allocated_bytes - before);
+    }
+    {
+        std::size_t before = allocated_bytes;
+        std::vector<T, CountingAllocator<T>> vector;
+        for (std::size_t i = 0; i < n; i++) vector.push_back(value);
+        print_row("std::vector", sizeof(T), n, sizeof(vector) + allocated_bytes - before);
+    }
+}
+
+template <typename T>
+void sweep() {
+    for (std::size_t n = 1; n <= 1000000; n *= 10) {
+        measure<T>(n);
+    }
+}
+
+}  // namespace
+
+int main() {
+    std::printf("container,sizeof_T,n,bytes,bytes_per_element,memory_usage\n");
+    sweep<Payload<4>>();
+    sweep<Payload<16>>();
+    sweep<Payload<64>>();
+    sweep<Payload<256>>();
+}
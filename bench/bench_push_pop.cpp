@@ -0,0 +1,113 @@
+/* End-operation and indexing micro benchmarks, Deque<int> against std::deque<int>.
+ * This is also the training run for the PGO build (tools/pgo.sh), so it deliberately exercises both directions of
+ * push and pop and the block-crossing branches of the index logic. */
+
+#include <deque>
+#include <random>
+
+#include "../src/Deque.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+const std::size_t repetitions = 5;
+
+template <typename Container>
+void fill_back(Container& container, std::size_t n) {
+    for (std::size_t i = 0; i < n; i++) container.push_back(static_cast<int>(i));
+}
+
+template <typename Container>
+double time_push_back(std::size_t n) {
+    return bench::measure_ns(repetitions, [n] {
+        Container container;
+        fill_back(container, n);
+        bench::do_not_optimize(container.back());
+    });
+}
+
+template <typename Container>
+double time_push_front(std::size_t n) {
+    return bench::measure_ns(repetitions, [n] {
+        Container container;
+        for (std::size_t i = 0; i < n; i++) container.push_front(static_cast<int>(i));
+        bench::do_not_optimize(container.front());
+    });
+}
+
+/* Pops are timed on a prefilled container; the fill is outside the timed region */
+template <typename Container, bool Back>
+double time_pop(std::size_t n) {
+    double best = 0;
+    for (std::size_t r = 0; r < repetitions; r++) {
+        Container container;
+        fill_back(container, n);
+        double sample = bench::measure_ns(1, [&container, n] {
+            for (std::size_t i = 0; i < n; i++) {
+                if (Back) {
+                    container.pop_back();
+                } else {
+                    container.pop_front();
+                }
+            }
+        });
+        best = r == 0 ? sample : std::min(best, sample);
+    }
+    return best;
+}
+
+/* FIFO: the front chases the back across blocks, so both ends keep crossing block boundaries */
+template <typename Container>
+double time_fifo(std::size_t n) {
+    return bench::measure_ns(repetitions, [n] {
+        Container container;
+        fill_back(container, 256);
+        for (std::size_t i = 0; i < n; i++) {
+            container.push_back(static_cast<int>(i));
+            container.pop_front();
+        }
+        bench::do_not_optimize(container.front());
+    });
+}
+
+template <typename Container>
+double time_random_index(std::size_t n, const std::vector<std::size_t>& indices) {
+    Container container;
+    fill_back(container, n);
+    return bench::measure_ns(repetitions, [&container, &indices] {
+        long sum = 0;
+        for (auto index : indices) sum += container[index];
+        bench::do_not_optimize(sum);
+    });
+}
+
+template <typename Container>
+double time_iterate(std::size_t n) {
+    Container container;
+    fill_back(container, n);
+    return bench::measure_ns(repetitions, [&container] {
+        long sum = 0;
+        for (auto it = container.begin(); it != container.end(); ++it) sum += *it;
+        bench::do_not_optimize(sum);
+    });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t n = bench::size_argument(argc, argv, 1000000);
+
+    std::mt19937 generator(42);
+    std::vector<std::size_t> indices(n);
+    for (auto& index : indices) index = generator() % n;
+
+    bench::print_header();
+    bench::print_row("push_back", n, time_push_back<Deque<int>>(n), time_push_back<std::deque<int>>(n));
+    bench::print_row("push_front", n, time_push_front<Deque<int>>(n), time_push_front<std::deque<int>>(n));
+    bench::print_row("pop_back", n, time_pop<Deque<int>, true>(n), time_pop<std::deque<int>, true>(n));
+    bench::print_row("pop_front", n, time_pop<Deque<int>, false>(n), time_pop<std::deque<int>, false>(n));
+    bench::print_row("fifo push_back+pop_front", n, time_fifo<Deque<int>>(n), time_fifo<std::deque<int>>(n));
+    bench::print_row("operator[] random", n, time_random_index<Deque<int>>(n, indices),
+                     time_random_index<std::deque<int>>(n, indices));
+    bench::print_row("iterate", n, time_iterate<Deque<int>>(n), time_iterate<std::deque<int>>(n));
+}
@@ -0,0 +1,82 @@
+/* p50 and p99 over the last n of a stream of skewed latency samples, answered after every sample. WindowedQuantile updates its
+ * skiplist per sample, against keeping the window in a Deque and sorting a copy per query, and against nth_element on a copy.
+ * The baselines only answer every 64th sample and are scaled to the same count. */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../src/WindowedQuantile.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+const std::size_t repetitions = 3;
+const std::size_t baseline_stride = 64;
+
+std::vector<double> latencies(std::size_t count) {
+    std::mt19937 generator(75);
+    std::lognormal_distribution<double> distribution(0.0, 0.8);
+    std::vector<double> samples(count);
+    for (double& sample : samples) sample = 1000 * distribution(generator);
+    return samples;
+}
+
+/*Index of the nearest-rank q-quantile in a sorted window of `size`, as WindowedQuantile::quantile defines it*/
+std::size_t nearest_rank(double q, std::size_t size) {
+    std::size_t rank = static_cast<std::size_t>(std::ceil(q * static_cast<double>(size)));
+    return rank == 0 ? 0 : rank - 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t window = bench::size_argument(argc, argv, 10000);
+    std::vector<double> stream = latencies(window * 4);
+    std::size_t queries = stream.size();
+
+    double sketched = bench::measure_ns(repetitions, [&] {
+        WindowedQuantile<double> sketch(window);
+        double sum = 0;
+        for (double sample : stream) {
+            sketch.push(sample);
+            sum += sketch.quantile(0.5) + sketch.quantile(0.99);
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    std::vector<double> copy;
+    auto baseline = [&](bool partial) {
+        return bench::measure_ns(repetitions, [&] {
+            Deque<double> recent;
+            double sum = 0;
+            for (std::size_t i = 0; i < stream.size(); i++) {
+                recent.push_back(stream[i]);
+                if (recent.get_size() > window) recent.pop_front();
+                if (i % baseline_stride != 0) continue;
+
+                copy = recent.to_vector();
+                std::size_t p50 = nearest_rank(0.5, copy.size());
+                std::size_t p99 = nearest_rank(0.99, copy.size());
+                if (partial) {
+                    std::nth_element(copy.begin(), copy.begin() + p50, copy.end());
+                    std::nth_element(copy.begin() + p50, copy.begin() + p99, copy.end());
+                } else {
+                    std::sort(copy.begin(), copy.end());
+                }
+                sum += copy[p50] + copy[p99];
+            }
+            bench::do_not_optimize(sum);
+        }) * baseline_stride;
+    };
+    double sorted = baseline(false);
+    double selected = baseline(true);
+
+    std::printf("%-24s %10s %12s %12s %9s\n", "operation", "window", "ns/sample", "sort ns", "ratio");
+    std::printf("%-24s %10zu %12.2f %12.2f %8.4fx\n", "WindowedQuantile", window, sketched / queries, sorted / queries,
+                sketched / sorted);
+    std::printf("%-24s %10zu %12.2f %12.2f %8.4fx\n", "copy + nth_element", window, selected / queries, sorted / queries,
+                selected / sorted);
+}
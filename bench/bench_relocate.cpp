@@ -0,0 +1,54 @@
+/* Middle insert/erase on deques of owning pointers: std::unique_ptr is marked trivially relocatable and moves by memmove, Boxed
+ * wraps the same pointer without the mark and moves element by element. */
+
+#include <deque>
+#include <memory>
+#include <random>
+
+#include "../src/Deque.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+const std::size_t repetitions = 3;
+
+struct Boxed {
+    std::unique_ptr<int> pointer;
+};
+
+template <typename Container, typename Make>
+double time_middle_edits(std::size_t size, std::size_t edits, Make make) {
+    Container container;
+    for (std::size_t i = 0; i < size; i++) container.push_back(make(static_cast<int>(i)));
+
+    std::mt19937 generator(23);
+    std::vector<std::size_t> positions(edits);
+    for (auto& position : positions) position = size / 4 + generator() % (size / 2);
+
+    return bench::measure_ns(repetitions, [&] {
+        for (std::size_t i = 0; i < edits; i++) {
+            if (i % 2 == 0) {
+                container.insert(container.begin() + positions[i], make(static_cast<int>(i)));
+            } else {
+                container.erase(container.begin() + positions[i]);
+            }
+        }
+    });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t size = bench::size_argument(argc, argv, 100000);
+    std::size_t edits = 2000;
+
+    auto make_unique = [](int v) { return std::make_unique<int>(v); };
+    auto make_boxed = [](int v) { return Boxed{std::make_unique<int>(v)}; };
+
+    double relocated = time_middle_edits<Deque<std::unique_ptr<int>>>(size, edits, make_unique);
+    double per_element = time_middle_edits<Deque<Boxed>>(size, edits, make_boxed);
+    double stl = time_middle_edits<std::deque<std::unique_ptr<int>>>(size, edits, make_unique);
+
+    std::printf("%-24s %10s %14s %14s %14s\n", "middle edits", "size", "memmove ns/op", "per-elem ns/op", "std ns/op");
+    std::printf("%-24s %10zu %14.1f %14.1f %14.1f\n", "insert+erase", size, relocated / edits, per_element / edits, stl / edits);
+}
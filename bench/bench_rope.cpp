@@ -0,0 +1,61 @@
+/* Middle insert/erase on a large buffer, editor style: the cursor wanders around the middle and each step inserts or erases one
+ * element next to it. RopeDeque against Deque and std::deque (std::vector behaves like std::deque here). */
+
+#include <deque>
+#include <random>
+
+#include "../src/Deque.hpp"
+#include "../src/RopeDeque.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+const std::size_t repetitions = 3;
+
+std::vector<std::size_t> make_cursor_walk(std::size_t size, std::size_t edits) {
+    std::mt19937 generator(5);
+    std::vector<std::size_t> cursor(edits);
+    std::size_t position = size / 2;
+    for (auto& step : cursor) {
+        position = (position + generator() % 64 + size - 32) % size;
+        step = position;
+    }
+    return cursor;
+}
+
+template <typename Container, typename Insert, typename Erase>
+double time_edits(std::size_t size, const std::vector<std::size_t>& cursor, Insert insert, Erase erase) {
+    Container container;
+    for (std::size_t i = 0; i < size; i++) container.push_back(static_cast<int>(i));
+
+    return bench::measure_ns(repetitions, [&] {
+        for (std::size_t i = 0; i < cursor.size(); i++) {
+            if (i % 2 == 0) {
+                insert(container, cursor[i], static_cast<int>(i));
+            } else {
+                erase(container, cursor[i]);
+            }
+        }
+    });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t size = bench::size_argument(argc, argv, 1000000);
+    std::size_t edits = 2000;
+    std::vector<std::size_t> cursor = make_cursor_walk(size, edits);
+
+    double rope = time_edits<RopeDeque<int>>(
+        size, cursor, [](RopeDeque<int>& c, std::size_t i, int v) { c.insert(i, v); },
+        [](RopeDeque<int>& c, std::size_t i) { c.erase(i); });
+    double deque = time_edits<Deque<int>>(
+        size, cursor, [](Deque<int>& c, std::size_t i, int v) { c.insert(c.begin() + i, v); },
+        [](Deque<int>& c, std::size_t i) { c.erase(c.begin() + i); });
+    double stl = time_edits<std::deque<int>>(
+        size, cursor, [](std::deque<int>& c, std::size_t i, int v) { c.insert(c.begin() + i, v); },
+        [](std::deque<int>& c, std::size_t i) { c.erase(c.begin() + i); });
+
+    std::printf("%-24s %10s %12s %12s %12s\n", "middle edits", "size", "Rope ns/op", "Deque ns/op", "std ns/op");
+    std::printf("%-24s %10zu %12.1f %12.1f %12.1f\n", "insert+erase", size, rope / edits, deque / edits, stl / edits);
+}
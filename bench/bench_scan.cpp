@@ -0,0 +1,85 @@
+/* Sequential scans over deques whose blocks are scattered through the heap, with and without the software prefetch of the next
+ * block: large elements (a 256-byte payload, one block is 16 KiB) and a huge deque of ints. The "plain" rows walk the same
+ * segments through segment(k), or the same elements through operator[], which never prefetch. */
+
+#include <cstdint>
+#include <memory>
+#include <random>
+
+#include "../src/Deque.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+const std::size_t repetitions = 3;
+
+struct Payload {
+    uint64_t key;
+    char bytes[248];
+};
+
+/* Interleaves every block allocation with a differently sized one, so consecutive blocks do not sit next to each other */
+template <typename T, typename Make>
+void fill_scattered(Deque<T>& deque, std::size_t n, Make make, std::vector<std::unique_ptr<char[]>>& noise) {
+    std::mt19937 generator(31);
+    for (std::size_t i = 0; i < n; i++) {
+        deque.push_back(make(i));
+        if (i % 64 == 0) noise.emplace_back(new char[1024 + generator() % 8192]);
+    }
+}
+
+template <typename T, typename Key>
+void run(const char* name, std::size_t n, Deque<T>& deque, Key key) {
+    double segments_prefetch = bench::measure_ns(repetitions, [&] {
+        uint64_t sum = 0;
+        deque.for_each_segment([&](DequeSegment<T*> segment) {
+            for (const T& value : segment) sum += key(value);
+        });
+        bench::do_not_optimize(sum);
+    });
+
+    double segments_plain = bench::measure_ns(repetitions, [&] {
+        uint64_t sum = 0;
+        for (std::size_t k = 0; k < deque.segment_count(); k++) {
+            for (const T& value : deque.segment(k)) sum += key(value);
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    double iterator_prefetch = bench::measure_ns(repetitions, [&] {
+        uint64_t sum = 0;
+        for (auto it = deque.begin(); it != deque.end(); ++it) sum += key(*it);
+        bench::do_not_optimize(sum);
+    });
+
+    double index_plain = bench::measure_ns(repetitions, [&] {
+        uint64_t sum = 0;
+        for (std::size_t i = 0; i < deque.get_size(); i++) sum += key(deque[i]);
+        bench::do_not_optimize(sum);
+    });
+
+    std::printf("%-12s %10zu %12.3f %12.3f %12.3f %12.3f\n", name, n, segments_prefetch / n, segments_plain / n,
+                iterator_prefetch / n, index_plain / n);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t n = bench::size_argument(argc, argv, 1 << 24);
+    std::vector<std::unique_ptr<char[]>> noise;
+
+    std::printf("prefetch distance %d blocks, %d lines\n", DEQUE_PREFETCH_DISTANCE, DEQUE_PREFETCH_LINES);
+    std::printf("%-12s %10s %12s %12s %12s %12s\n", "scan ns/elem", "n", "for_each_seg", "segment(k)", "iterator",
+                "operator[]");
+
+    Deque<Payload> large;
+    std::size_t large_n = n / 64;
+    fill_scattered(large, large_n, [](std::size_t i) { return Payload{i, {}}; }, noise);
+    run("256B T", large_n, large, [](const Payload& p) { return p.key; });
+    large.clear();
+    large.shrink_to_fit();
+
+    Deque<uint32_t> huge;
+    fill_scattered(huge, n, [](std::size_t i) { return static_cast<uint32_t>(i); }, noise);
+    run("huge N", n, huge, [](uint32_t v) { return v; });
+}
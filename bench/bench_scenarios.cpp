@@ -0,0 +1,339 @@
+/* Scenario benchmarks modeled on how queues are used in production rather than on push loops, so map growth, idle block
+ * reuse and block churn show up in the numbers:
+ *
+ *   fifo_bounded       steady FIFO with a 100k backlog, fully drained four times (the consumer catching up)
+ *   bursty             producer bursts of 1..4096 items against a consumer taking 1500 per tick
+ *   window_minmax      sliding-window min and max over 1000 samples with two monotonic deques
+ *   random_access      1M elements, 80% random reads mixed with pushes and pops at both ends
+ *   large_object_fifo  FIFO of 256-byte payloads with a 4096 backlog
+ *   handoff_mt         producer and consumer threads handing items over through a mutex-wrapped queue
+ *
+ * followed by four kernels that regressions usually show up in first: push_back into a fresh queue, random operator[],
+ * iteration, and resize (queues growing from empty at both ends, so the map is regrown and recentered over and over).
+ *
+ * Each scenario runs on Deque and std::deque with fixed seeds and sizes, so every build replays the same operation sequence.
+ * Prints a table of the fastest run per operation, or with --json every run, for comparing builds.
+ *
+ *   bench_scenarios [--json] [--repetitions N] [--scale X] [--filter NAME] */
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/Deque.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+template <typename T>
+using OwnDeque = Deque<T>;
+
+template <typename T>
+using StdDeque = std::deque<T>;
+
+template <typename T>
+std::size_t size_of(const Deque<T>& queue) {
+    return queue.get_size();
+}
+
+template <typename T>
+std::size_t size_of(const std::deque<T>& queue) {
+    return queue.size();
+}
+
+struct Payload {
+    uint64_t words[32];
+};
+
+/*==============================================================^SCENARIOS^===============================================================*/
+
+template <template <typename> class Queue>
+void fifo_bounded(std::size_t operations) {
+    const std::size_t backlog = 100000;
+    Queue<uint64_t> queue;
+    uint64_t checksum = 0;
+    for (std::size_t i = 0; i < operations; i++) {
+        queue.push_back(i);
+        if (size_of(queue) > backlog) {
+            checksum += queue.front();
+            queue.pop_front();
+        }
+        if ((i + 1) % (operations / 4) == 0) {
+            while (size_of(queue) > 0) {
+                checksum += queue.front();
+                queue.pop_front();
+            }
+        }
+    }
+    bench::do_not_optimize(checksum);
+}
+
+template <template <typename> class Queue>
+void bursty(std::size_t operations) {
+    std::mt19937 generator(73);
+    Queue<uint64_t> queue;
+    uint64_t checksum = 0;
+    for (std::size_t produced = 0; produced < operations;) {
+        std::size_t burst = std::min<std::size_t>(std::size_t(1) << (generator() % 13), operations - produced);
+        for (std::size_t i = 0; i < burst; i++) queue.push_back(produced + i);
+        produced += burst;
+        for (std::size_t i = 0; i < 1500 && size_of(queue) > 0; i++) {
+            checksum += queue.front();
+            queue.pop_front();
+        }
+    }
+    bench::do_not_optimize(checksum);
+}
+
+template <template <typename> class Queue>
+void window_minmax(const std::vector<uint32_t>& series) {
+    const std::size_t window = 1000;
+    Queue<uint32_t> lows;                                            // Indices with increasing values.
+    Queue<uint32_t> highs;                                           // Indices with decreasing values.
+    uint64_t checksum = 0;
+    for (uint32_t i = 0; i < series.size(); i++) {
+        uint32_t value = series[i];
+        while (size_of(lows) > 0 && series[lows.back()] >= value) lows.pop_back();
+        while (size_of(highs) > 0 && series[highs.back()] <= value) highs.pop_back();
+        lows.push_back(i);
+        highs.push_back(i);
+        if (lows.front() + window <= i) lows.pop_front();
+        if (highs.front() + window <= i) highs.pop_front();
+        if (i + 1 >= window) checksum += series[lows.front()] + series[highs.front()];
+    }
+    bench::do_not_optimize(checksum);
+}
+
+/*The queue keeps its size: every push is paired with a pop at the other end*/
+template <typename Queue>
+void random_access(Queue& queue, std::size_t operations) {
+    std::mt19937 generator(74);
+    uint64_t checksum = 0;
+    for (std::size_t i = 0; i < operations; i++) {
+        uint32_t draw = generator();
+        switch (draw % 10) {
+            case 0:
+                queue.push_back(i);
+                queue.pop_front();
+                break;
+            case 1:
+                queue.push_front(i);
+                queue.pop_back();
+                break;
+            default:
+                checksum += queue[(draw >> 4) % size_of(queue)];
+                break;
+        }
+    }
+    bench::do_not_optimize(checksum);
+}
+
+template <template <typename> class Queue>
+void large_object_fifo(std::size_t operations) {
+    const std::size_t backlog = 4096;
+    Queue<Payload> queue;
+    Payload payload;
+    std::memset(&payload, 0, sizeof(payload));
+    uint64_t checksum = 0;
+    for (std::size_t i = 0; i < operations; i++) {
+        payload.words[0] = i;
+        payload.words[31] = i * 3;
+        queue.push_back(payload);
+        if (size_of(queue) > backlog) {
+            checksum += queue.front().words[0] + queue.front().words[31];
+            queue.pop_front();
+        }
+    }
+    bench::do_not_optimize(checksum);
+}
+
+/*One lock per push; the consumer takes up to 64 items per lock and sleeps on the condition variable when the queue is empty*/
+template <template <typename> class Queue>
+void handoff_mt(std::size_t operations) {
+    Queue<uint64_t> queue;
+    std::mutex mutex;
+    std::condition_variable ready;
+    uint64_t checksum = 0;
+
+    std::thread consumer([&] {
+        for (std::size_t taken = 0; taken < operations;) {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [&] { return size_of(queue) > 0; });
+            for (std::size_t i = 0; i < 64 && size_of(queue) > 0; i++, taken++) {
+                checksum += queue.front();
+                queue.pop_front();
+            }
+        }
+    });
+    for (std::size_t i = 0; i < operations; i++) {
+        bool was_empty;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            was_empty = size_of(queue) == 0;
+            queue.push_back(i);
+        }
+        if (was_empty) {
+            ready.notify_one();
+        }
+    }
+    consumer.join();
+    bench::do_not_optimize(checksum);
+}
+
+template <template <typename> class Queue>
+void push_back(std::size_t operations) {
+    Queue<uint64_t> queue;
+    for (std::size_t i = 0; i < operations; i++) queue.push_back(i);
+    bench::do_not_optimize(queue.back());
+}
+
+template <typename Queue>
+void random_index(const Queue& queue, std::size_t operations) {
+    std::mt19937 generator(76);
+    uint64_t checksum = 0;
+    for (std::size_t i = 0; i < operations; i++) checksum += queue[generator() % size_of(queue)];
+    bench::do_not_optimize(checksum);
+}
+
+template <typename Queue>
+void iterate(const Queue& queue) {
+    uint64_t checksum = 0;
+    for (uint64_t value : queue) checksum += value;
+    bench::do_not_optimize(checksum);
+}
+
+/*Many queues built up from empty at both ends: map regrowth and recentering plus first-touch block allocation*/
+template <template <typename> class Queue>
+void resize(std::size_t operations) {
+    const std::size_t size = std::min<std::size_t>(20000, operations);
+    for (std::size_t built = 0; built < operations; built += size) {
+        Queue<uint64_t> queue;
+        for (std::size_t i = 0; i < size / 2; i++) {
+            queue.push_back(i);
+            queue.push_front(i);
+        }
+        bench::do_not_optimize(queue.front());
+    }
+}
+
+/*================================================================^DRIVER^================================================================*/
+
+struct Scenario {
+    const char* name;
+    std::size_t operations;
+    std::function<void()> deque;
+    std::function<void()> stl;
+};
+
+struct Options {
+    bool json = false;
+    std::size_t repetitions = 7;
+    double scale = 1.0;
+    std::string filter;
+};
+
+Options parse_options(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--json") == 0) {
+            options.json = true;
+        } else if (std::strcmp(argv[i], "--repetitions") == 0 && has_value) {
+            options.repetitions = std::max<std::size_t>(1, std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--scale") == 0 && has_value) {
+            options.scale = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--filter") == 0 && has_value) {
+            options.filter = argv[++i];
+        } else {
+            std::fprintf(stderr, "usage: %s [--json] [--repetitions N] [--scale X] [--filter NAME]\n", argv[0]);
+            std::exit(2);
+        }
+    }
+    return options;
+}
+
+void print_samples(const char* name, const char* container, std::size_t operations, const std::vector<double>& samples,
+                   bool& first) {
+    std::printf("%s\n    {\"name\": \"%s\", \"container\": \"%s\", \"operations\": %zu, ", first ? "" : ",", name, container,
+                operations);
+    std::printf("\"unit\": \"ns/op\", \"samples\": [");
+    for (std::size_t i = 0; i < samples.size(); i++) {
+        std::printf("%s%.4f", i == 0 ? "" : ", ", samples[i] / operations);
+    }
+    std::printf("]}");
+    first = false;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options = parse_options(argc, argv);
+    auto scaled = [&options](std::size_t operations) {
+        return std::max<std::size_t>(4, static_cast<std::size_t>(operations * options.scale));
+    };
+
+    std::vector<uint32_t> series(scaled(4000000));
+    std::mt19937 generator(75);
+    for (auto& value : series) value = generator();
+
+    Deque<uint64_t> deque_table;                                     // random_access keeps working on the same 1M elements.
+    std::deque<uint64_t> stl_table;
+    for (std::size_t i = 0; i < scaled(1000000); i++) {
+        deque_table.push_back(i);
+        stl_table.push_back(i);
+    }
+
+    std::size_t fifo = scaled(4000000);
+    std::size_t burst = scaled(4000000);
+    std::size_t mix = scaled(2000000);
+    std::size_t large = scaled(1000000);
+    std::size_t handoff = scaled(200000);
+    std::size_t pushes = scaled(4000000);
+    std::size_t growth = scaled(2000000);
+    std::vector<Scenario> scenarios = {
+        {"fifo_bounded", fifo, [=] { fifo_bounded<OwnDeque>(fifo); }, [=] { fifo_bounded<StdDeque>(fifo); }},
+        {"bursty", burst, [=] { bursty<OwnDeque>(burst); }, [=] { bursty<StdDeque>(burst); }},
+        {"window_minmax", series.size(), [&] { window_minmax<OwnDeque>(series); }, [&] { window_minmax<StdDeque>(series); }},
+        {"random_access", mix, [&, mix] { random_access(deque_table, mix); }, [&, mix] { random_access(stl_table, mix); }},
+        {"large_object_fifo", large, [=] { large_object_fifo<OwnDeque>(large); }, [=] { large_object_fifo<StdDeque>(large); }},
+        {"handoff_mt", handoff, [=] { handoff_mt<OwnDeque>(handoff); }, [=] { handoff_mt<StdDeque>(handoff); }},
+        {"push_back", pushes, [=] { push_back<OwnDeque>(pushes); }, [=] { push_back<StdDeque>(pushes); }},
+        {"operator[]", mix, [&, mix] { random_index(deque_table, mix); }, [&, mix] { random_index(stl_table, mix); }},
+        {"iterate", deque_table.get_size(), [&] { iterate(deque_table); }, [&] { iterate(stl_table); }},
+        {"resize", growth, [=] { resize<OwnDeque>(growth); }, [=] { resize<StdDeque>(growth); }},
+    };
+
+    bool first = true;
+    if (options.json) {
+        std::printf("{\"suite\": \"scenarios\", \"compiler\": \"%s\", \"repetitions\": %zu, \"scale\": %g, \"results\": [", __VERSION__,
+                    options.repetitions, options.scale);
+    } else {
+        bench::print_header();
+    }
+    for (const Scenario& scenario : scenarios) {
+        if (!options.filter.empty() && options.filter != scenario.name) {
+            continue;
+        }
+        std::vector<double> mine = bench::measure_samples(options.repetitions, scenario.deque);
+        std::vector<double> stl = bench::measure_samples(options.repetitions, scenario.stl);
+        if (options.json) {
+            print_samples(scenario.name, "Deque", scenario.operations, mine, first);
+            print_samples(scenario.name, "std::deque", scenario.operations, stl, first);
+        } else {
+            bench::print_row(scenario.name, scenario.operations, *std::min_element(mine.begin(), mine.end()),
+                             *std::min_element(stl.begin(), stl.end()));
+        }
+    }
+    if (options.json) {
+        std::printf("\n]}\n");
+    }
+}
@@ -0,0 +1,133 @@
+/* Two processes passing 64-byte messages: a pipe (one write/read syscall per message), ShmDeque with one producer (per message
+ * and in spans of 32) and ShmDeque with the sequenced multi-producer cells. The producer is a forked child, the consumer is the
+ * parent; both yield when the queue is full or empty, so the numbers also hold on a single core. */
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <sched.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../src/ShmDeque.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+const std::size_t repetitions = 3;
+const std::size_t capacity = 4096;
+const std::size_t span = 32;
+
+struct Message {
+    uint64_t sequence;
+    uint64_t payload[7];
+};
+
+/*Forks a child running produce(), runs consume() in the parent and waits for the child*/
+template <typename Produce, typename Consume>
+void run_pair(Produce produce, Consume consume) {
+    pid_t pid = ::fork();
+    if (pid < 0) {
+        std::perror("fork");
+        std::exit(1);
+    }
+    if (pid == 0) {
+        produce();
+        ::_exit(0);
+    }
+    consume();
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+}
+
+double time_pipe(std::size_t n) {
+    return bench::measure_ns(repetitions, [n] {
+        int fds[2];
+        if (::pipe(fds) != 0) {
+            std::perror("pipe");
+            std::exit(1);
+        }
+        run_pair(
+            [&] {
+                ::close(fds[0]);
+                Message message{};
+                for (std::size_t i = 0; i < n; i++) {
+                    message.sequence = i;
+                    if (::write(fds[1], &message, sizeof(message)) != static_cast<ssize_t>(sizeof(message))) ::_exit(1);
+                }
+            },
+            [&] {
+                ::close(fds[1]);
+                Message message{};
+                uint64_t checksum = 0;
+                for (std::size_t i = 0; i < n; i++) {
+                    std::size_t done = 0;
+                    while (done < sizeof(message)) {
+                        ssize_t got = ::read(fds[0], reinterpret_cast<char*>(&message) + done, sizeof(message) - done);
+                        if (got <= 0) std::exit(1);
+                        done += static_cast<std::size_t>(got);
+                    }
+                    checksum += message.sequence;
+                }
+                ::close(fds[0]);
+                bench::do_not_optimize(checksum);
+            });
+    });
+}
+
+template <ShmProducers Producers, bool Spans>
+double time_shm(std::size_t n) {
+    std::string name = "/own_deque_bench_" + std::to_string(::getpid());
+    return bench::measure_ns(repetitions, [n, &name] {
+        auto consumer = ShmDeque<Message, Producers>::create(name, capacity);
+        run_pair(
+            [&] {
+                auto producer = ShmDeque<Message, Producers>::open(name);
+                Message messages[span] = {};
+                for (std::size_t i = 0; i < n;) {
+                    if (Spans) {
+                        std::size_t count = std::min(span, n - i);
+                        for (std::size_t k = 0; k < count; k++) messages[k].sequence = i + k;
+                        std::size_t pushed = 0;
+                        while ((pushed += producer.push_span(messages + pushed, count - pushed)) < count) ::sched_yield();
+                        i += count;
+                    } else {
+                        messages[0].sequence = i;
+                        while (!producer.try_push(messages[0])) ::sched_yield();
+                        i++;
+                    }
+                }
+            },
+            [&] {
+                Message messages[span];
+                uint64_t checksum = 0;
+                for (std::size_t i = 0; i < n;) {
+                    std::size_t popped = Spans ? consumer.pop_batch(messages, span) : consumer.try_pop(messages[0]);
+                    if (popped == 0) {
+                        ::sched_yield();
+                        continue;
+                    }
+                    for (std::size_t k = 0; k < popped; k++) checksum += messages[k].sequence;
+                    i += popped;
+                }
+                bench::do_not_optimize(checksum);
+            });
+        ShmDeque<Message, Producers>::unlink(name);
+    });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t n = bench::size_argument(argc, argv, 1000000);
+
+    double pipe = time_pipe(n);
+    double spsc = time_shm<ShmProducers::single, false>(n);
+    double spsc_spans = time_shm<ShmProducers::single, true>(n);
+    double mpsc = time_shm<ShmProducers::multiple, false>(n);
+
+    std::printf("%-24s %10s %12s %12s %12s %12s\n", "ns/message", "n", "pipe", "spsc", "spsc spans", "mpsc");
+    std::printf("%-24s %10zu %12.1f %12.1f %12.1f %12.1f\n", "64-byte messages", n, pipe / n, spsc / n, spsc_spans / n,
+                mpsc / n);
+}
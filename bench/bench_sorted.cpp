@@ -0,0 +1,68 @@
+/* Mostly time-ordered queue: SortedDeque against std::multiset. Each tick inserts one event that is up to `lateness` ticks late
+ * and expires the oldest one once the window is full, then the whole window is scanned once per 1000 ticks. */
+
+#include <random>
+#include <set>
+
+#include "../src/SortedDeque.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+const std::size_t repetitions = 3;
+const std::size_t window = 100000;
+
+std::vector<int> make_stream(std::size_t n, int lateness) {
+    std::mt19937 generator(1);
+    std::vector<int> stream(n);
+    for (std::size_t t = 0; t < n; t++) {
+        stream[t] = static_cast<int>(t) - static_cast<int>(generator() % lateness);
+    }
+    return stream;
+}
+
+double time_sorted_deque(const std::vector<int>& stream) {
+    return bench::measure_ns(repetitions, [&stream] {
+        SortedDeque<int> queue;
+        long sum = 0;
+        for (std::size_t t = 0; t < stream.size(); t++) {
+            queue.insert(stream[t]);
+            if (queue.get_size() > window) queue.pop_front();
+            if (t % 1000 == 0) {
+                for (std::size_t k = 0; k < queue.deque().segment_count(); k++) {
+                    for (int value : queue.deque().segment(k)) sum += value;
+                }
+            }
+        }
+        bench::do_not_optimize(sum);
+    });
+}
+
+double time_multiset(const std::vector<int>& stream) {
+    return bench::measure_ns(repetitions, [&stream] {
+        std::multiset<int> queue;
+        long sum = 0;
+        for (std::size_t t = 0; t < stream.size(); t++) {
+            queue.insert(stream[t]);
+            if (queue.size() > window) queue.erase(queue.begin());
+            if (t % 1000 == 0) {
+                for (int value : queue) sum += value;
+            }
+        }
+        bench::do_not_optimize(sum);
+    });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t n = bench::size_argument(argc, argv, 1000000);
+
+    std::printf("%-24s %10s %12s %12s %9s\n", "lateness", "n", "Sorted ns/op", "multiset", "ratio");
+    for (int lateness : {1, 16, 256, 4096}) {
+        std::vector<int> stream = make_stream(n, lateness);
+        char name[32];
+        std::snprintf(name, sizeof(name), "up to %d late", lateness);
+        bench::print_row(name, n, time_sorted_deque(stream), time_multiset(stream));
+    }
+}
@@ -0,0 +1,99 @@
+/* Merging two deques of n ints and rotating one by a third of its length. splice_back relinks the blocks when the offsets line
+ * up (aligned) and shifts the smaller deque first when they do not (unaligned), against an append loop over the second deque and
+ * std::deque::insert. rotate against a pop_front/push_back loop and std::rotate on std::deque. split_at(n / 2) against copying the
+ * tail out through the iterators and popping it, and the same on std::deque. Only the operation is timed. */
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+
+#include "../src/Deque.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+const std::size_t repetitions = 5;
+
+/*Fastest of `repetitions` runs of operation(), each after a fresh setup()*/
+template <typename Setup, typename Operation>
+double time_operation(Setup setup, Operation operation) {
+    double best = 0;
+    for (std::size_t i = 0; i < repetitions; i++) {
+        auto state = setup();
+        auto start = std::chrono::steady_clock::now();
+        operation(state);
+        auto stop = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double, std::nano>(stop - start).count();
+        best = i == 0 ? elapsed : std::min(best, elapsed);
+        bench::do_not_optimize(state);
+    }
+    return best;
+}
+
+template <typename Container>
+Container make(std::size_t n, std::size_t pad) {
+    Container container;
+    for (std::size_t i = 0; i < n + pad; i++) container.push_back(static_cast<int>(i));
+    for (std::size_t i = 0; i < pad; i++) container.pop_front();
+    return container;
+}
+
+template <typename Container>
+struct Pair {
+    Container left;
+    Container right;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t n = bench::size_argument(argc, argv, 1 << 20);
+    std::size_t k = n / 3;
+
+    auto pair = [n](std::size_t pad) {
+        return [n, pad] { return Pair<Deque<int>>{make<Deque<int>>(n, 0), make<Deque<int>>(n, pad)}; };
+    };
+    auto stl_pair = [n] { return Pair<std::deque<int>>{make<std::deque<int>>(n, 0), make<std::deque<int>>(n, 0)}; };
+
+    double stl_merge = time_operation(stl_pair, [](Pair<std::deque<int>>& p) {
+        p.left.insert(p.left.end(), p.right.begin(), p.right.end());
+    });
+    double aligned = time_operation(pair(0), [](Pair<Deque<int>>& p) { p.left.splice_back(std::move(p.right)); });
+    double unaligned = time_operation(pair(17), [](Pair<Deque<int>>& p) { p.left.splice_back(std::move(p.right)); });
+    double appended = time_operation(pair(0), [](Pair<Deque<int>>& p) {
+        for (int value : p.right) p.left.push_back(value);
+        p.right.clear();
+    });
+
+    auto single = [n] { return make<Deque<int>>(n - n % 64, 0); };
+    auto stl_single = [n] { return make<std::deque<int>>(n - n % 64, 0); };
+    double stl_rotate = time_operation(stl_single, [k](std::deque<int>& d) { std::rotate(d.begin(), d.begin() + k, d.end()); });
+    double rotated = time_operation(single, [k](Deque<int>& d) { d.rotate(k); });
+    double looped = time_operation(single, [k](Deque<int>& d) {
+        for (std::size_t i = 0; i < k; i++) {
+            d.push_back(d.front());
+            d.pop_front();
+        }
+    });
+
+    auto whole = [n] { return Pair<Deque<int>>{make<Deque<int>>(n, 0), Deque<int>()}; };
+    auto stl_whole = [n] { return Pair<std::deque<int>>{make<std::deque<int>>(n, 0), std::deque<int>()}; };
+    double stl_split = time_operation(stl_whole, [n](Pair<std::deque<int>>& p) {
+        p.right.assign(p.left.begin() + n / 2, p.left.end());
+        p.left.erase(p.left.begin() + n / 2, p.left.end());
+    });
+    double split = time_operation(whole, [n](Pair<Deque<int>>& p) { p.right = p.left.split_at(n / 2); });
+    double copied = time_operation(whole, [n](Pair<Deque<int>>& p) {
+        for (auto it = p.left.begin() + n / 2; it != p.left.end(); ++it) p.right.push_back(*it);
+        while (p.left.get_size() > n / 2) p.left.pop_back();
+    });
+
+    bench::print_header();
+    bench::print_row("splice_back aligned", n, aligned, stl_merge);
+    bench::print_row("splice_back unaligned", n, unaligned, stl_merge);
+    bench::print_row("push_back loop", n, appended, stl_merge);
+    bench::print_row("rotate n/3", n, rotated, stl_rotate);
+    bench::print_row("pop/push loop n/3", n, looped, stl_rotate);
+    bench::print_row("split_at n/2", n, split, stl_split);
+    bench::print_row("iterator copy n/2", n, copied, stl_split);
+}
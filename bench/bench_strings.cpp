@@ -0,0 +1,113 @@
+/* Log-line queue: lines of 60-120 characters pushed at the back and popped at the front once the window is full, then a scan
+ * summing the line lengths and first characters. StringDeque against Deque<std::string> and std::deque<std::string>, with the
+ * number of operator new calls per thousand lines in the steady state. */
+
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <new>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../src/StringDeque.hpp"
+#include "bench_common.hpp"
+
+namespace {
+
+std::size_t allocations = 0;
+
+const std::size_t repetitions = 3;
+const std::size_t window = 8192;
+
+std::vector<std::string> make_lines(std::size_t n) {
+    std::mt19937 generator(68);
+    std::vector<std::string> lines(n);
+    for (auto& line : lines) {
+        line.assign(60 + generator() % 60, ' ');
+        for (auto& c : line) c = static_cast<char>('a' + generator() % 26);
+    }
+    return lines;
+}
+
+struct Result {
+    double queue_ns;
+    double scan_ns;
+    double allocations_per_thousand;
+};
+
+template <typename Queue, typename Scan>
+Result run(const std::vector<std::string>& lines, Scan scan) {
+    Result result{};
+    result.queue_ns = bench::measure_ns(repetitions, [&] {
+        Queue queue;
+        std::size_t warm = 2 * window;
+        std::size_t before = 0;
+        for (std::size_t i = 0; i < lines.size(); i++) {
+            if (i == warm) before = allocations;
+            queue.push_back(lines[i]);
+            if (i >= window) queue.pop_front();
+        }
+        result.allocations_per_thousand = 1000.0 * static_cast<double>(allocations - before) / (lines.size() - warm);
+
+        uint64_t checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < 10; pass++) checksum += scan(queue);
+        auto stop = std::chrono::steady_clock::now();
+        result.scan_ns = std::chrono::duration<double, std::nano>(stop - start).count() / (10.0 * window);
+        bench::do_not_optimize(checksum);
+    });
+    return result;
+}
+
+template <typename Queue>
+uint64_t scan_indexed(const Queue& queue) {
+    uint64_t checksum = 0;
+    for (std::size_t i = 0; i < queue.get_size(); i++) {
+        std::string_view line = queue[i];
+        checksum += line.size() + static_cast<unsigned char>(line[0]);
+    }
+    return checksum;
+}
+
+void print(const char* name, std::size_t n, const Result& result) {
+    std::printf("%-28s %10zu %12.2f %12.2f %14.2f\n", name, n, result.queue_ns / n, result.scan_ns, result.allocations_per_thousand);
+}
+
+}  // namespace
+
+void* operator new(std::size_t bytes) {
+    allocations++;
+    if (void* storage = std::malloc(bytes)) {
+        return storage;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* storage) noexcept { std::free(storage); }
+void operator delete(void* storage, std::size_t) noexcept { std::free(storage); }
+
+int main(int argc, char** argv) {
+    std::size_t n = bench::size_argument(argc, argv, 400000);
+    std::vector<std::string> lines = make_lines(n);
+
+    Result string_deque = run<StringDeque>(lines, [](const StringDeque& queue) {
+        uint64_t checksum = 0;
+        queue.for_each([&checksum](std::string_view line) { checksum += line.size() + static_cast<unsigned char>(line[0]); });
+        return checksum;
+    });
+    Result indexed = run<StringDeque>(lines, scan_indexed<StringDeque>);
+    Result deque = run<Deque<std::string>>(lines, scan_indexed<Deque<std::string>>);
+    Result stl = run<std::deque<std::string>>(lines, [](const std::deque<std::string>& queue) {
+        uint64_t checksum = 0;
+        for (const auto& line : queue) checksum += line.size() + static_cast<unsigned char>(line[0]);
+        return checksum;
+    });
+
+    std::printf("%-28s %10s %12s %12s %14s\n", "container", "n", "push/pop ns", "scan ns", "allocs/1000");
+    print("StringDeque (for_each)", n, string_deque);
+    print("StringDeque (operator[])", n, indexed);
+    print("Deque<std::string>", n, deque);
+    print("std::deque<std::string>", n, stl);
+}
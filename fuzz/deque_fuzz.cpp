@@ -0,0 +1,414 @@
+/* Differential fuzz target: the input bytes are decoded into a sequence of operations that are applied both to
+ * Deque<int> and to std::deque<int>; after every operation the two containers must agree.
+ *
+ *   libFuzzer:   clang++ -fsanitize=fuzzer,address fuzz/deque_fuzz.cpp
+ *   AFL:         afl-clang++ -DDEQUE_FUZZ_STANDALONE fuzz/deque_fuzz.cpp, then run with @@
+ *   standalone:  -DDEQUE_FUZZ_STANDALONE, see usage() below (deterministic seed mode is the default) */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+
+#include "../src/Deque.hpp"
+
+#define FUZZ_CHECK(condition)                                                                   \
+    do {                                                                                        \
+        if (!(condition)) {                                                                     \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            std::abort();                                                                       \
+        }                                                                                       \
+    } while (0)
+
+namespace {
+
+class ByteReader {
+private:
+    const uint8_t* data;
+    std::size_t size;
+    std::size_t position = 0;
+
+public:
+    ByteReader(const uint8_t* _data, std::size_t _size) : data(_data), size(_size) {}
+
+    bool exhausted() const { return this->position >= this->size; }
+
+    uint8_t byte() { return this->exhausted() ? 0 : this->data[this->position++]; }
+
+    int value() {
+        uint32_t result = 0;
+        for (int i = 0; i < 4; i++) {
+            result = (result << 8) | this->byte();
+        }
+        return static_cast<int>(result);
+    }
+
+    /* Positions are taken modulo the bound, so every input decodes to a valid operation */
+    std::size_t position_in(std::size_t bound) {
+        uint16_t raw = static_cast<uint16_t>((this->byte() << 8) | this->byte());
+        return bound == 0 ? 0 : raw % bound;
+    }
+};
+
+/* A full comparison after every operation makes long inputs quadratic, so the cheap end checks run every step */
+const std::size_t full_check_period = 16;
+
+void check_ends(Deque<int>& deque, const std::deque<int>& model) {
+    FUZZ_CHECK(deque.get_size() == model.size());
+    FUZZ_CHECK(deque.empty() == model.empty());
+
+    if (!model.empty()) {
+        FUZZ_CHECK(deque.front() == model.front());
+        FUZZ_CHECK(deque.back() == model.back());
+    }
+}
+
+void check_equal(Deque<int>& deque, const std::deque<int>& model) {
+    check_ends(deque, model);
+
+    std::size_t index = 0;
+    for (auto it = deque.begin(); it != deque.end(); it.operator++(), index++) {
+        FUZZ_CHECK(index < model.size());
+        FUZZ_CHECK(*it == model[index]);
+    }
+    FUZZ_CHECK(index == model.size());
+
+    index = 0;
+    for (std::size_t k = 0; k < deque.segment_count(); k++) {
+        auto segment = deque.segment(k);
+        FUZZ_CHECK(segment.size > 0);
+        FUZZ_CHECK(deque.segment_offset(k) == index);
+        for (int value : segment) {
+            FUZZ_CHECK(deque.segment_of(index) == k);
+            FUZZ_CHECK(value == model[index++]);
+        }
+    }
+    FUZZ_CHECK(index == model.size());
+}
+
+enum Operation : uint8_t {
+    PUSH_BACK,
+    PUSH_FRONT,
+    POP_BACK,
+    POP_FRONT,
+    WRITE_INDEX,
+    READ_INDEX,
+    INSERT,
+    ERASE,
+    BULK_PUSH_BACK,
+    BULK_PUSH_FRONT,
+    COPY,
+    ASSIGN,
+    SHRINK,
+    APPEND,
+    PREPEND,
+    POP_FRONT_INTO,
+    COPY_OUT,
+    SPLICE,
+    ROTATE,
+    SPLIT,
+    OPERATION_COUNT
+};
+
+void run_operations(const uint8_t* data, std::size_t size) {
+    ByteReader reader(data, size);
+    Deque<int> deque(size > 0 && (data[0] & 0x80) != 0 ? DequeBlockSizing::adaptive : DequeBlockSizing::fixed);
+    std::deque<int> model;
+    std::size_t step = 0;
+
+    while (!reader.exhausted()) {
+        switch (reader.byte() % OPERATION_COUNT) {
+            case PUSH_BACK: {
+                int value = reader.value();
+                deque.push_back(value);
+                model.push_back(value);
+                break;
+            }
+            case PUSH_FRONT: {
+                int value = reader.value();
+                deque.push_front(value);
+                model.push_front(value);
+                break;
+            }
+            case POP_BACK:
+                deque.pop_back();  // Deque documents pop on empty as a no-op, std::deque does not
+                if (!model.empty()) model.pop_back();
+                break;
+            case POP_FRONT:
+                deque.pop_front();
+                if (!model.empty()) model.pop_front();
+                break;
+            case WRITE_INDEX: {
+                if (model.empty()) break;
+                std::size_t index = reader.position_in(model.size());
+                int value = reader.value();
+                deque[index] = value;
+                model[index] = value;
+                break;
+            }
+            case READ_INDEX: {
+                if (model.empty()) break;
+                std::size_t index = reader.position_in(model.size());
+                FUZZ_CHECK(deque[index] == model[index]);
+                FUZZ_CHECK(deque.at(index) == model.at(index));
+                break;
+            }
+            case INSERT: {
+                std::size_t index = reader.position_in(model.size() + 1);
+                int value = reader.value();
+                deque.insert(deque.begin() + index, value);
+                model.insert(model.begin() + index, value);
+                break;
+            }
+            case ERASE: {
+                if (model.empty()) break;
+                std::size_t index = reader.position_in(model.size());
+                deque.erase(deque.begin() + index);
+                model.erase(model.begin() + index);
+                break;
+            }
+            case BULK_PUSH_BACK:
+            case BULK_PUSH_FRONT: {
+                /* Long runs are what cross block boundaries and trigger resize() */
+                bool back = (reader.byte() & 1) == 0;
+                std::size_t count = reader.byte();
+                for (std::size_t i = 0; i < count; i++) {
+                    int value = static_cast<int>(i);
+                    if (back) {
+                        deque.push_back(value);
+                        model.push_back(value);
+                    } else {
+                        deque.push_front(value);
+                        model.push_front(value);
+                    }
+                }
+                break;
+            }
+            case COPY: {
+                Deque<int> copy(deque);
+                check_equal(copy, model);
+                copy.push_back(reader.value());  // must not be visible through the original
+                copy.pop_front();
+                check_equal(deque, model);
+                break;
+            }
+            case ASSIGN: {
+                Deque<int> other;
+                other.push_back(reader.value());
+                other = deque;
+                check_equal(other, model);
+                deque = other;
+                break;
+            }
+            case SHRINK: {
+                deque.shrink_to_fit();
+                DequeMemoryUsage usage = deque.memory_usage();
+                FUZZ_CHECK(usage.idle_block_bytes == 0);
+                FUZZ_CHECK(usage.live_block_bytes >= model.size() * sizeof(int));
+                break;
+            }
+            case APPEND:
+            case PREPEND: {
+                std::vector<int> values(reader.byte() * 2);
+                for (std::size_t i = 0; i < values.size(); i++) values[i] = static_cast<int>(i) - 7;
+                if ((reader.byte() & 1) == 0) {
+                    deque.append(values.data(), values.size());
+                    model.insert(model.end(), values.begin(), values.end());
+                } else {
+                    deque.prepend(values.data(), values.size());
+                    model.insert(model.begin(), values.begin(), values.end());
+                }
+                break;
+            }
+            case POP_FRONT_INTO: {
+                std::vector<int> batch(reader.byte() * 2);
+                std::size_t taken = deque.pop_front_into(batch.data(), batch.size());
+                FUZZ_CHECK(taken == std::min(batch.size(), model.size()));
+                for (std::size_t i = 0; i < taken; i++) {
+                    FUZZ_CHECK(batch[i] == model.front());
+                    model.pop_front();
+                }
+                break;
+            }
+            case COPY_OUT: {
+                std::vector<int> flat = deque.to_vector();
+                FUZZ_CHECK(std::equal(flat.begin(), flat.end(), model.begin(), model.end()));
+                DequeSegment<int*> linear = deque.linearize();
+                if (model.size() <= deque.block_size()) {
+                    FUZZ_CHECK(linear.size == model.size());
+                    FUZZ_CHECK(std::equal(linear.begin(), linear.end(), model.begin(), model.end()));
+                }
+                break;
+            }
+            case SPLICE: {
+                /* The other deque gets its own front offset, so both the relinking and the shifting path run */
+                Deque<int> other;
+                std::size_t pad = reader.byte() % 64;
+                std::size_t count = reader.byte() * 3;
+                for (std::size_t i = 0; i < pad + count; i++) other.push_back(static_cast<int>(i));
+                for (std::size_t i = 0; i < pad; i++) other.pop_front();
+                std::vector<int> values(other.begin(), other.end());
+                if ((reader.byte() & 1) == 0) {
+                    deque.splice_back(std::move(other));
+                    model.insert(model.end(), values.begin(), values.end());
+                } else {
+                    deque.splice_front(std::move(other));
+                    model.insert(model.begin(), values.begin(), values.end());
+                }
+                FUZZ_CHECK(other.empty());
+                break;
+            }
+            case ROTATE: {
+                std::size_t k = reader.byte() * 5;
+                deque.rotate(k);
+                if (!model.empty()) std::rotate(model.begin(), model.begin() + k % model.size(), model.end());
+                break;
+            }
+            case SPLIT: {
+                std::size_t index = reader.position_in(model.size() + 1);
+                Deque<int> tail = deque.split_at(index);
+                FUZZ_CHECK(tail.get_size() == model.size() - index);
+                FUZZ_CHECK(std::equal(tail.begin(), tail.end(), model.begin() + index, model.end()));
+                if ((reader.byte() & 1) == 0) {
+                    model.erase(model.begin() + index, model.end());
+                } else {
+                    deque.splice_back(std::move(tail));
+                }
+                break;
+            }
+        }
+
+        if (++step % full_check_period == 0) {
+            check_equal(deque, model);
+        } else {
+            check_ends(deque, model);
+        }
+    }
+
+    check_equal(deque, model);
+}
+
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, std::size_t size) {
+    run_operations(data, size);
+    return 0;
+}
+
+#ifdef DEQUE_FUZZ_STANDALONE
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const uint32_t seed_corpus_seed = 0x5eed;
+const std::size_t seed_corpus_default_count = 2000;
+
+void usage(const char* program) {
+    std::fprintf(stderr,
+                 "usage: %s                        run the deterministic seed corpus\n"
+                 "       %s --seeds N              run N deterministic seeds\n"
+                 "       %s --write-corpus DIR     dump the seed corpus into DIR for libFuzzer/AFL\n"
+                 "       %s FILE|DIR...            replay inputs (AFL: @@)\n",
+                 program, program, program, program);
+}
+
+/* The seed corpus is generated from a fixed PRNG seed, so a failure reproduces on every machine */
+std::vector<std::vector<uint8_t>> make_seed_corpus(std::size_t count) {
+    std::mt19937 generator(seed_corpus_seed);
+    std::vector<std::vector<uint8_t>> corpus;
+
+    for (std::size_t i = 0; i < count; i++) {
+        std::size_t length = 1 + generator() % (i % 10 == 0 ? 4096 : 256);
+        std::vector<uint8_t> input(length);
+        for (auto& byte : input) {
+            byte = static_cast<uint8_t>(generator());
+        }
+        corpus.push_back(std::move(input));
+    }
+
+    return corpus;
+}
+
+bool replay_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::fprintf(stderr, "cannot open %s\n", path.c_str());
+        return false;
+    }
+    std::vector<uint8_t> input((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    LLVMFuzzerTestOneInput(input.data(), input.size());
+    return true;
+}
+
+bool replay_path(const std::string& path) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) {
+        std::fprintf(stderr, "cannot stat %s\n", path.c_str());
+        return false;
+    }
+    if (!S_ISDIR(info.st_mode)) {
+        return replay_file(path);
+    }
+
+    DIR* directory = opendir(path.c_str());
+    if (directory == nullptr) return false;
+
+    bool ok = true;
+    while (dirent* entry = readdir(directory)) {
+        if (entry->d_name[0] == '.') continue;
+        ok = replay_path(path + "/" + entry->d_name) && ok;
+    }
+    closedir(directory);
+    return ok;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 1 || (argc == 3 && std::strcmp(argv[1], "--seeds") == 0)) {
+        std::size_t count = argc == 3 ? std::strtoul(argv[2], nullptr, 10) : seed_corpus_default_count;
+        for (auto& input : make_seed_corpus(count)) {
+            LLVMFuzzerTestOneInput(input.data(), input.size());
+        }
+        std::printf("deque_fuzz: %zu deterministic seeds passed\n", count);
+        return 0;
+    }
+
+    if (argc == 3 && std::strcmp(argv[1], "--write-corpus") == 0) {
+        std::size_t index = 0;
+        for (auto& input : make_seed_corpus(seed_corpus_default_count)) {
+            std::string path = std::string(argv[2]) + "/seed-" + std::to_string(index++);
+            std::ofstream file(path, std::ios::binary);
+            file.write(reinterpret_cast<const char*>(input.data()), static_cast<std::streamsize>(input.size()));
+            if (!file) {
+                std::fprintf(stderr, "cannot write %s\n", path.c_str());
+                return 1;
+            }
+        }
+        return 0;
+    }
+
+    if (argv[1][0] == '-') {
+        usage(argv[0]);
+        return 2;
+    }
+
+    bool ok = true;
+    for (int i = 1; i < argc; i++) {
+        ok = replay_path(argv[i]) && ok;
+    }
+    return ok ? 0 : 1;
+}
+
+#endif  // DEQUE_FUZZ_STANDALONE
@@ -0,0 +1,143 @@
+#ifndef SRC_ARENA_DEQUE_HPP_
+#define SRC_ARENA_DEQUE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+
+#include "Deque.hpp"
+
+/* Monotonic bump arena for request-scoped deques: allocate() is a pointer bump, nothing is freed individually, release() drops
+ * everything at once. The memory comes in chunks from operator new; when a request needed several chunks, release() replaces
+ * them with one chunk of the combined size, so the next request of the same shape never leaves the bump path.
+ *
+ * A deque allocates from the arena of the innermost DequeArena::Scope on the thread that constructs it, for its whole life;
+ * copies, assignments and split_at tails use the source's arena. Every deque using the arena must be destroyed before
+ * release() or the arena's destructor: its elements live in the arena.*/
+class DequeArena {
+public:
+    static const std::size_t alignment = alignof(std::max_align_t);
+
+    explicit DequeArena(std::size_t _chunk_bytes = 64 * 1024) : chunk_bytes(_chunk_bytes) {}
+
+    DequeArena(const DequeArena&) = delete;
+    DequeArena& operator=(const DequeArena&) = delete;
+
+    ~DequeArena() { this->free_chunks(); }
+
+    void* allocate(std::size_t bytes) {
+        bytes = (bytes + alignment - 1) / alignment * alignment;
+        if (static_cast<std::size_t>(this->limit - this->cursor) < bytes) {
+            this->add_chunk(bytes);
+        }
+        void* storage = this->cursor;
+        this->cursor += bytes;
+        this->used += bytes;
+        return storage;
+    }
+
+    /*Frees everything allocated since the last release, keeping one chunk big enough for all of it*/
+    void release() noexcept {
+        if (this->chunks != nullptr && this->chunks->next != nullptr) {
+            std::size_t total = 0;
+            for (Chunk* chunk = this->chunks; chunk != nullptr; chunk = chunk->next) {
+                total += chunk->bytes;
+            }
+            this->free_chunks();
+            this->chunk_bytes = std::max(this->chunk_bytes, total);
+        }
+        if (this->chunks != nullptr) {
+            this->cursor = reinterpret_cast<char*>(this->chunks) + header_bytes;
+        }
+        this->used = 0;
+    }
+
+    /*Bytes handed out since the last release*/
+    std::size_t bytes_used() const noexcept { return this->used; }
+
+    std::size_t chunk_count() const noexcept {
+        std::size_t count = 0;
+        for (Chunk* chunk = this->chunks; chunk != nullptr; chunk = chunk->next) {
+            count++;
+        }
+        return count;
+    }
+
+    /*Makes `arena` the current arena of this thread until the scope ends; scopes nest*/
+    class Scope {
+    public:
+        explicit Scope(DequeArena& arena) : previous(current_slot()) { current_slot() = &arena; }
+        ~Scope() { current_slot() = this->previous; }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        DequeArena* previous;
+    };
+
+    /*Arena of the innermost live Scope on this thread, nullptr outside of any*/
+    static DequeArena* current() noexcept { return current_slot(); }
+
+private:
+    struct Chunk {
+        Chunk* next;
+        std::size_t bytes;                                           // Usable bytes after the header.
+    };
+
+    static const std::size_t header_bytes = (sizeof(Chunk) + alignment - 1) / alignment * alignment;
+
+    Chunk* chunks = nullptr;
+    char* cursor = nullptr;
+    char* limit = nullptr;
+    std::size_t used = 0;
+    std::size_t chunk_bytes;
+
+    void add_chunk(std::size_t bytes) {
+        std::size_t size = std::max(this->chunk_bytes, bytes);
+        Chunk* chunk = static_cast<Chunk*>(::operator new(header_bytes + size));
+        chunk->next = this->chunks;
+        chunk->bytes = size;
+        this->chunks = chunk;
+        this->cursor = reinterpret_cast<char*>(chunk) + header_bytes;
+        this->limit = this->cursor + size;
+    }
+
+    void free_chunks() noexcept {
+        while (this->chunks != nullptr) {
+            Chunk* next = this->chunks->next;
+            ::operator delete(this->chunks);
+            this->chunks = next;
+        }
+        this->cursor = nullptr;
+        this->limit = nullptr;
+    }
+
+    static DequeArena*& current_slot() noexcept {
+        thread_local DequeArena* arena = nullptr;
+        return arena;
+    }
+};
+
+/*Block policy over the DequeArena that was current when the deque was constructed; the deque keeps allocating from it when
+ * moved or grown outside that scope. deallocate is a no-op: pop_*, resize() and shrink_to_fit() never give memory back, the
+ * arena does it in bulk*/
+struct ArenaBlockAllocator {
+    static void* context() {
+        DequeArena* arena = DequeArena::current();
+        if (arena == nullptr) {
+            throw std::logic_error("ArenaDeque: no DequeArena::Scope on this thread");
+        }
+        return arena;
+    }
+
+    static void* allocate(void* arena, std::size_t bytes) { return static_cast<DequeArena*>(arena)->allocate(bytes); }
+
+    static void deallocate(void*, void*, std::size_t) noexcept {}
+};
+
+template <typename T>
+using ArenaDeque = Deque<T, ArenaBlockAllocator>;
+
+#endif  // SRC_ARENA_DEQUE_HPP_
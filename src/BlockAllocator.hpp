@@ -0,0 +1,231 @@
+#ifndef SRC_BLOCK_ALLOCATOR_HPP_
+#define SRC_BLOCK_ALLOCATOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+/*Block allocation policies for Deque. A policy is a type with two static functions,
+ *     static void* allocate(std::size_t bytes);
+ *     static void deallocate(void* storage, std::size_t bytes);
+ * used for the element blocks and the map; DequeCore reaches them through BlockAllocatorOps. deallocate gets the same byte
+ * count allocate did and is never called with nullptr.
+ *
+ * A policy whose memory depends on where the deque was made (ArenaBlockAllocator) also has
+ *     static void* context();
+ * which a deque calls once, when it is constructed, and then passes as the first argument of allocate(context, bytes) and
+ * deallocate(context, storage, bytes) for as long as it lives. Moves, copies and split_at share the source's context.*/
+
+/*Every block straight from the global operator new*/
+struct HeapBlockAllocator {
+    static void* allocate(std::size_t bytes) { return ::operator new(bytes); }
+    static void deallocate(void* storage, std::size_t) noexcept { ::operator delete(storage); }
+};
+
+/* Free blocks are cached per thread in size classes, so a service that constructs and destroys deques all the time stops calling
+ * malloc once the caches are warm. Classes are four steps per power of two from 64 bytes to 1 MiB (at most 25% slack); bigger
+ * requests bypass the cache.
+ *
+ * Each thread keeps at most `thread_limit` blocks per class. When a list overflows, half of it goes to the central pool (one
+ * mutex, at most `central_limit` blocks per class, the rest is freed), and an empty list refills with up to `batch` blocks from
+ * there before falling back to operator new. A thread that exits hands its blocks to the central pool. The central pool is never
+ * destroyed, so deques with static storage duration can still free their blocks at exit. */
+class CachedBlockAllocator {
+public:
+    static const std::size_t min_bytes = 64;
+    static const std::size_t max_bytes = std::size_t(1) << 20;
+    static const std::size_t class_count = 57;                      // 64 bytes plus 4 classes for each of 2^6 .. 2^19.
+    static const std::size_t thread_limit = 32;
+    static const std::size_t batch = thread_limit / 2;
+    static const std::size_t central_limit = 1024;
+
+    /*Size class of a request of `bytes`; class_count for requests the cache does not handle*/
+    static std::size_t class_of(std::size_t bytes) noexcept {
+        if (bytes <= min_bytes) {
+            return 0;
+        }
+        if (bytes > max_bytes) {
+            return class_count;
+        }
+        std::size_t p = floor_log2(bytes - 1);                       // 2^p < bytes <= 2^(p+1)
+        std::size_t step = std::size_t(1) << (p - 2);
+        std::size_t k = (bytes - (std::size_t(1) << p) + step - 1) / step;
+        return (p - 6) * 4 + k;
+    }
+
+    /*Bytes actually handed out for class c*/
+    static std::size_t class_bytes(std::size_t c) noexcept {
+        if (c == 0) {
+            return min_bytes;
+        }
+        std::size_t p = (c - 1) / 4 + 6;
+        std::size_t k = (c - 1) % 4 + 1;
+        return (std::size_t(1) << p) + k * (std::size_t(1) << (p - 2));
+    }
+
+    /*Fast paths stay small enough to inline into push and pop; everything else is out of line*/
+    static void* allocate(std::size_t bytes) {
+        std::size_t c = class_of(bytes);
+        ThreadCache* cache = thread_cache();
+        if (c < class_count && cache != nullptr && cache->lists[c].count > 0) {
+            return cache->lists[c].pop();
+        }
+        return allocate_slow(bytes, c, cache);
+    }
+
+    static void deallocate(void* storage, std::size_t bytes) noexcept {
+        std::size_t c = class_of(bytes);
+        ThreadCache* cache = thread_cache();
+        if (c < class_count && cache != nullptr && cache->lists[c].count < thread_limit) {
+            cache->lists[c].push(storage);
+            return;
+        }
+        deallocate_slow(storage, bytes, c, cache);
+    }
+
+    /*Blocks cached by the calling thread, over all classes*/
+    static std::size_t thread_cached_blocks() noexcept {
+        ThreadCache* cache = thread_cache();
+        std::size_t total = 0;
+        for (std::size_t c = 0; cache != nullptr && c < class_count; c++) {
+            total += cache->lists[c].count;
+        }
+        return total;
+    }
+
+    /*Blocks parked in the central pool, over all classes*/
+    static std::size_t central_blocks() {
+        return central().size();
+    }
+
+private:
+    /*Intrusive LIFO list threaded through the first word of the free blocks*/
+    struct FreeList {
+        void* head = nullptr;
+        std::size_t count = 0;
+
+        void push(void* storage) noexcept {
+            *static_cast<void**>(storage) = this->head;
+            this->head = storage;
+            this->count++;
+        }
+
+        void* pop() noexcept {
+            void* storage = this->head;
+            this->head = *static_cast<void**>(storage);
+            this->count--;
+            return storage;
+        }
+    };
+
+    class Central {
+    public:
+        /*Moves up to `batch` blocks of class c into list*/
+        void take(std::size_t c, FreeList& list) {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            for (std::size_t i = 0; i < batch && this->lists[c].count > 0; i++) {
+                list.push(this->lists[c].pop());
+            }
+        }
+
+        /*Moves `count` blocks of class c out of list; what does not fit under central_limit is freed*/
+        void give(std::size_t c, FreeList& list, std::size_t count) noexcept {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            for (std::size_t i = 0; i < count; i++) {
+                void* storage = list.pop();
+                if (this->lists[c].count < central_limit) {
+                    this->lists[c].push(storage);
+                } else {
+                    ::operator delete(storage);
+                }
+            }
+        }
+
+        std::size_t size() {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            std::size_t total = 0;
+            for (const auto& list : this->lists) {
+                total += list.count;
+            }
+            return total;
+        }
+
+    private:
+        std::mutex mutex;
+        FreeList lists[class_count];
+    };
+
+    struct ThreadCache {
+        FreeList lists[class_count];
+
+        ~ThreadCache() {
+            for (std::size_t c = 0; c < class_count; c++) {
+                central().give(c, this->lists[c], this->lists[c].count);
+            }
+            exited() = true;
+        }
+    };
+
+    __attribute__((noinline)) static void* allocate_slow(std::size_t bytes, std::size_t c, ThreadCache* cache) {
+        if (c == class_count) {
+            return ::operator new(bytes);
+        }
+        if (cache != nullptr) {
+            central().take(c, cache->lists[c]);
+            if (cache->lists[c].count > 0) {
+                return cache->lists[c].pop();
+            }
+        }
+        return ::operator new(class_bytes(c));
+    }
+
+    __attribute__((noinline)) static void deallocate_slow(void* storage, std::size_t, std::size_t c, ThreadCache* cache) noexcept {
+        if (c == class_count) {
+            ::operator delete(storage);
+            return;
+        }
+        if (cache == nullptr) {                                     // Thread is exiting: its cache is gone already.
+            FreeList single;
+            single.push(storage);
+            central().give(c, single, 1);
+            return;
+        }
+        FreeList& list = cache->lists[c];                           // Full: keep `batch` blocks, pass the rest on.
+        list.push(storage);
+        central().give(c, list, list.count - batch);
+    }
+
+    static std::size_t floor_log2(std::size_t value) noexcept {
+        return sizeof(unsigned long long) * 8 - 1 - static_cast<std::size_t>(__builtin_clzll(value));
+    }
+
+    static Central& central() {
+        static Central* pool = new Central();                       // Leaked on purpose, see the class comment.
+        return *pool;
+    }
+
+    static bool& exited() noexcept {
+        thread_local bool flag = false;
+        return flag;
+    }
+
+    /*nullptr once the calling thread's cache has been destroyed*/
+    static ThreadCache* thread_cache() noexcept {
+        if (exited()) {
+            return nullptr;
+        }
+        thread_local ThreadCache cache;
+        return &cache;
+    }
+};
+
+/*Blocks come from the thread cache unless DEQUE_NO_BLOCK_CACHE is defined: sanitizer builds want every block to go through
+ * malloc so use-after-free and leaks stay visible*/
+#ifdef DEQUE_NO_BLOCK_CACHE
+using DefaultBlockAllocator = HeapBlockAllocator;
+#else
+using DefaultBlockAllocator = CachedBlockAllocator;
+#endif
+
+#endif  // SRC_BLOCK_ALLOCATOR_HPP_
@@ -2,25 +2,97 @@
 #define SRC_DEQUE_HPP_
 
 #include <algorithm>
-#include <iostream>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 #include <cassert>
+#if __cplusplus >= 202002L
+#include <ranges>
+#endif
 
-#define EXTERNAL_INIT_SIZE 2
-                                                                       /*
-                                                                     |  *                        *[] -> nullptr
-                                                                     |  *                        *[] -> nullptr
-             Data structure                                          |  * first_storage          *[] -> [uninit_zone ... value[current_first] ... values]
-             organization                                            |  *                        *[] -> [       ...      values          ...            ]
-                                                                     |  *                        *[] -> [       ...      values          ...            ]
-The reasion to use vector as external storage instead of list is     |  * last_storage           *[] -> [values ... value[current_last] ... uninit_zone]
-a random acces iterator category. Using list will give asymptotic    |  *                        *[] -> nullptr
-of basic operations better, but using vector gives us the same       |  *
-amortization time that we can have with using list.                  |  *   external_storage_size = 4 * initial_size - uninit_zone
-                                                                     |  *   external_capacity = external_storage.size() * initial_size
-                                                                     |  *
-                                                                        */
-template <typename T>
+#include "DequeCore.hpp"
+#include "TriviallyRelocatable.hpp"
+
+/*Checked mode: compile with -DDEQUE_CHECKED (CMake option DEQUE_CHECKED) to bounds-check operator[], front() and back() and to
+ * reject iterators used after the deque changed shape. Both throw; without the macro none of it is compiled in. at() is always
+ * checked.*/
+
+/*Contiguous run of elements inside a single block. Segment 0 starts at the front element, only the first and the last segment
+ * can be partial*/
+template <typename Pointer>
+struct DequeSegment {
+    Pointer data = nullptr;
+    std::size_t size = 0;
+
+    Pointer begin() const noexcept { return this->data; }
+    Pointer end() const noexcept { return this->data + this->size; }
+};
+/*The segments of a deque as a random access range of DequeSegment values, made by Deque::segments(). Like std::views::iota it
+ * yields prvalues, so C++17 algorithms see an input range and C++20 ranges a random_access_range. Unlike for_each_segment it
+ * does not prefetch*/
+template <typename Owner, typename Pointer>
+class DequeSegmentView {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using iterator_concept = std::random_access_iterator_tag;
+        using value_type = DequeSegment<Pointer>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = DequeSegment<Pointer>;
+
+        iterator() = default;
+        iterator(Owner* _deque, std::size_t _k) noexcept : deque(_deque), k(_k) {}
+
+        reference operator*() const noexcept { return this->deque->segment(this->k); }
+        reference operator[](difference_type offset) const noexcept { return this->deque->segment(this->k + offset); }
+
+        iterator& operator++() noexcept { return *this += 1; }
+        iterator& operator--() noexcept { return *this -= 1; }
+        iterator operator++(int) noexcept { iterator result = *this; this->k++; return result; }
+        iterator operator--(int) noexcept { iterator result = *this; this->k--; return result; }
+
+        iterator& operator+=(difference_type offset) noexcept { this->k += offset; return *this; }
+        iterator& operator-=(difference_type offset) noexcept { this->k -= offset; return *this; }
+        iterator operator+(difference_type offset) const noexcept { return iterator(this->deque, this->k + offset); }
+        iterator operator-(difference_type offset) const noexcept { return iterator(this->deque, this->k - offset); }
+        friend iterator operator+(difference_type offset, const iterator& it) noexcept { return it + offset; }
+        friend difference_type operator-(const iterator& lhs, const iterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.k - rhs.k);
+        }
+
+        friend bool operator==(const iterator& lhs, const iterator& rhs) noexcept { return lhs.k == rhs.k; }
+        friend bool operator!=(const iterator& lhs, const iterator& rhs) noexcept { return lhs.k != rhs.k; }
+        friend bool operator<(const iterator& lhs, const iterator& rhs) noexcept { return lhs.k < rhs.k; }
+        friend bool operator>(const iterator& lhs, const iterator& rhs) noexcept { return lhs.k > rhs.k; }
+        friend bool operator<=(const iterator& lhs, const iterator& rhs) noexcept { return lhs.k <= rhs.k; }
+        friend bool operator>=(const iterator& lhs, const iterator& rhs) noexcept { return lhs.k >= rhs.k; }
+
+    private:
+        Owner* deque = nullptr;
+        std::size_t k = 0;
+    };
+
+    DequeSegmentView() = default;
+    explicit DequeSegmentView(Owner* _deque) noexcept : deque(_deque) {}
+
+    iterator begin() const noexcept { return iterator(this->deque, 0); }
+    iterator end() const noexcept { return iterator(this->deque, this->deque->segment_count()); }
+    std::size_t size() const noexcept { return this->deque->segment_count(); }
+    DequeSegment<Pointer> operator[](std::size_t k) const noexcept { return this->deque->segment(k); }
+
+private:
+    Owner* deque = nullptr;
+};
+
+/*BlockAllocator is a static allocation policy (see BlockAllocator.hpp) serving both the blocks and the map*/
+template <typename T, typename BlockAllocator = DefaultBlockAllocator>
 class Deque {
 private:
     typedef T value_type;
@@ -31,337 +103,947 @@ private:
     typedef value_type& reference;
     typedef const T& const_reference;
 
-    const static std::size_t initial_size = 64;
-    std::size_t pivot = 0;
-    std::size_t current_first = (initial_size - 1) / 2 - 1;
-    std::size_t current_last = (initial_size - 1) / 2;
-    std::size_t first_storage = 0;
-    std::size_t last_storage = 0;
-    std::size_t external_storage_size = 0;
-    std::size_t external_capacity = initial_size;
-    std::vector<pointer> external_storage;
+    DequeCore core;                                                  // Map, indices and blocks, shared by every T.
     
     /*This implementation use a sequence of individually allocated fixed-size arrays, with additional bookkeeping, which means indexed access to deque 
      * must perform two pointer dereferences, compared to vector's indexed access which performs only one. Expansion of a deque is cheaper than the
-     * expansion of a std::vector because it does not involve copying of the existing elements to a new memory location. 
+     * expansion of a std::vector because it does not involve copying of the existing elements to a new memory location. */
 
    /*===================================================================*IMPLEMENTATION*=======================================================================*/
 
 
-    /* Вообще оператор new может не вызывать конструктор по умолчанию и выдать просто кусок сырой памяти, что вызовет ub */
-    pointer make_storage() noexcept {
-        pointer new_storage = reinterpret_cast<T*>(new char[this->initial_size * sizeof(value_type)]);
-        return new_storage;
+    void check_index(std::size_t index, const char* message) const {
+        if (index >= this->core.size()) {
+            throw std::out_of_range(message);
+        }
+    }
+
+    /*Called by the iterator after each step: only the step onto a block's first slot issues the prefetch*/
+    void prefetch_ahead(std::size_t index) const noexcept {
+        std::size_t position = this->core.front_position() + index;
+        if (position % this->block_size() == 0) {
+            this->core.prefetch_block(position / this->block_size());
+        }
+    }
+
+    /*=================================================================^ELEMENT_LIFETIME^==================================================================*/
+
+    /* Blocks are raw memory: an element slot is constructed by push_*, destroyed by pop_*, and the index bookkeeping in the core
+     * never touches the objects themselves. */
+
+    /*Relocating can throw only for T that is neither trivially relocatable nor nothrow move constructible. For such T insert
+     * and erase shift by assignment like std::deque, splice_* and split_at move elements one block at a time instead of
+     * realigning blocks, and each relocation copies every element before destroying any*/
+    static constexpr bool nothrow_relocatable = is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible<T>::value;
+
+    /*Typed address of a position in `core`*/
+    static pointer address(const DequeCore& core, std::size_t position) noexcept {
+        return static_cast<pointer>(core.block(position / core.block_size())) + position % core.block_size();
+    }
+
+    /*Typed address of a core position*/
+    pointer at_position(std::size_t position) const noexcept { return address(this->core, position); }
+
+    /*Address of slot `index` counted from the front; index == size is the raw slot push_back would construct next*/
+    pointer slot(std::size_t index) const noexcept {
+        return this->at_position(this->core.front_position() + index);
+    }
+
+    /*Destroys elements [first, first + count)*/
+    void destroy_range(std::size_t first, std::size_t count) noexcept {
+        if (std::is_trivially_destructible<T>::value) {
+            return;
+        }
+        for (std::size_t i = 0; i < count; i++) {
+            std::destroy_at(this->slot(first + i));
+        }
+    }
+
+    /*Runs a core advance for the `count` elements just constructed at `first`. The advance may throw while allocating a block,
+     * leaving the core unchanged; the elements are destroyed then, so the push fails without a trace*/
+    template <typename Advance>
+    static bool take_in(pointer first, std::size_t count, Advance advance) {
+        if constexpr (std::is_trivially_destructible<T>::value) {
+            return advance();
+        } else {
+            try {
+                return advance();
+            } catch (...) {
+                std::destroy(first, first + count);
+                throw;
+            }
+        }
+    }
+
+    /* Relocates count elements stored contiguously at source to the raw slots at target: afterwards the source slots are raw.
+     * When a copy can throw the ranges must not overlap: every element is copied (moved if that cannot throw) before the sources
+     * are destroyed, and a throw destroys the copies made so far, leaving both ranges as they were */
+    static void relocate_contiguous(pointer source, pointer target, std::size_t count, bool backward) noexcept(nothrow_relocatable) {
+        if constexpr (is_trivially_relocatable_v<T>) {
+            std::memmove(static_cast<void*>(target), static_cast<const void*>(source), count * sizeof(T));
+        } else if constexpr (std::is_nothrow_move_constructible<T>::value) {
+            for (std::size_t n = 0; n < count; n++) {
+                std::size_t i = backward ? count - 1 - n : n;
+                ::new (static_cast<void*>(target + i)) T(std::move(source[i]));
+                std::destroy_at(source + i);
+            }
+        } else {
+            std::size_t built = 0;
+            try {
+                for (; built < count; built++) {
+                    ::new (static_cast<void*>(target + built)) T(std::move_if_noexcept(source[built]));
+                }
+            } catch (...) {
+                std::destroy(target, target + built);
+                throw;
+            }
+            std::destroy(source, source + count);
+        }
+    }
+
+    /*Copies a segment to constructed objects at target*/
+    static void copy_segment(DequeSegment<const T*> segment, T* target) noexcept(std::is_trivially_copyable<T>::value) {
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            std::memcpy(static_cast<void*>(target), segment.data, segment.size * sizeof(T));
+        } else {
+            std::copy(segment.begin(), segment.end(), target);
+        }
+    }
+
+    /* Relocates elements [from, from + count) to [to, to + count), where every target slot is either raw or part of the source
+     * range. The range is cut at the block boundaries of both sides, so each piece is one memmove for trivially relocatable T.
+     * The pieces may overlap, so only T whose relocation cannot throw may come here */
+    void relocate(std::size_t from, std::size_t to, std::size_t count) noexcept(nothrow_relocatable) {
+        std::size_t front = this->core.front_position();
+
+        if (to > from) {
+            while (count > 0) {
+                std::size_t source_room = (front + from + count - 1) % this->block_size() + 1;
+                std::size_t target_room = (front + to + count - 1) % this->block_size() + 1;
+                std::size_t chunk = std::min({count, source_room, target_room});
+                count -= chunk;
+                relocate_contiguous(this->slot(from + count), this->slot(to + count), chunk, true);
+            }
+        } else {
+            for (std::size_t done = 0; done < count;) {
+                std::size_t source_room = this->block_size() - (front + from + done) % this->block_size();
+                std::size_t target_room = this->block_size() - (front + to + done) % this->block_size();
+                std::size_t chunk = std::min({count - done, source_room, target_room});
+                relocate_contiguous(this->slot(from + done), this->slot(to + done), chunk, false);
+                done += chunk;
+            }
+        }
     }
 
-    /* Дисклеймер (ЗДЕСЬ МОГ БЫТЬ ВАШ ЛИСТ), однако определенным образом подбирая initial_size - константа степени 2(символично),
-     * мы можем практически избежать вызова метода resize, поддерживать операции за все те же O(1). Метод крайне простоват:
-     * создаем новый внешний сторедж(вектор) размер X2, затем присваиваем внутренним стореджам внутренние стореджи старого вектора.
-     * При этом по сути поэлементного копирования не происходит. (Вся сложность поддерживать индексы как на примере в самом верху) */
-    void resize() noexcept {
-        std::size_t new_size = this->external_storage.size() * 2;
-        std::vector<pointer> new_external_storage(new_size);
-        std::size_t new_pivot = new_size / 2 - 1;
-        int upper_offset = static_cast<int>(this->first_storage - this->pivot);      // Данные величины вполне могут оказаться.
-        int lower_offset = static_cast<int>(this->last_storage - this->pivot);       // отрицательными, особенно в случае верхнего смещения.
-        this->pivot = new_pivot;
-        std::size_t storage = new_pivot + upper_offset;
+    /* Moves the elements into `target`, an empty core of this deque's element size, and swaps it in; the old blocks leave with
+     * target. Every target slot is taken before the first element moves, and T whose relocation can throw are all copied before
+     * the old ones are destroyed, so a throw leaves the deque as it was */
+    void repack_into(DequeCore& target) {
+        std::size_t size = this->core.size();
+        for (std::size_t taken = 0; taken < size;) {
+            std::size_t chunk = std::min(size - taken, target.back_room());
+            target.advance_back_by(chunk);
+            taken += chunk;
+        }
+
+        std::size_t first = target.front_position();
+        if constexpr (nothrow_relocatable) {
+            std::size_t position = first;
+            for (std::size_t k = 0; k < this->segment_count(); k++) {
+                DequeSegment<pointer> segment = this->segment(k);
+                for (std::size_t done = 0; done < segment.size;) {
+                    std::size_t chunk = std::min(segment.size - done, target.block_size() - position % target.block_size());
+                    relocate_contiguous(segment.data + done, address(target, position), chunk, false);
+                    done += chunk;
+                    position += chunk;
+                }
+            }
+        } else {
+            std::size_t built = 0;
+            try {
+                for (; built < size; built++) {
+                    ::new (static_cast<void*>(address(target, first + built))) T(std::move_if_noexcept(*this->slot(built)));
+                }
+            } catch (...) {
+                for (std::size_t i = 0; i < built; i++) {
+                    std::destroy_at(address(target, first + i));
+                }
+                throw;
+            }
+            this->destroy_range(0, size);
+        }
+        this->core.swap(target);
+    }
 
-        for (std::size_t i = this->first_storage; i <= this->last_storage; i++, storage++) {  // Связываем новые и старые стореджи.
-            new_external_storage[storage] = this->external_storage[i];
+    /* Adaptive mode: repacks the elements into a core with blocks twice as large. The push that asked for the repack has already
+     * succeeded, so a failure is swallowed: the deque keeps its blocks and asks again at its next block change */
+    void grow_blocks() noexcept {
+        try {
+            DequeCore larger(sizeof(value_type), this->core.block_allocator(), DequeBlockSizing::adaptive, this->core.next_block_size());
+            this->repack_into(larger);
+        } catch (...) {
         }
+    }
 
-        for (std::size_t i = 0; i < this->first_storage; i++) {
-            delete [] this->external_storage[i];                                      // Удаляем те, в которых не было значений.
+    /*Moves every element `delta` (< block_size()) slots toward the front: each in-block offset drops by delta, modulo the block*/
+    void shift_toward_front(std::size_t delta) {
+        std::size_t size = this->core.size();
+        for (std::size_t taken = 0; taken < delta;) {
+            std::size_t chunk = std::min(delta - taken, this->core.front_room());
+            try {
+                this->core.advance_front_by(chunk);
+            } catch (...) {
+                this->core.drop_front(taken);                        // Give back the raw slots already taken.
+                throw;
+            }
+            taken += chunk;
         }
-        for (std::size_t i = this->last_storage + 1; i < this->external_storage.size(); i++) {
-            delete [] this->external_storage[i];
+        this->relocate(delta, 0, size);
+        this->core.retreat_back_by(delta);
+    }
+
+    /*Relocates up to count elements from source's front to target's back, at most a block at a time; returns how many. source and
+     * target may be the same deque*/
+    static std::size_t move_front_to_back(Deque& source, Deque& target, std::size_t count) {
+        count = std::min(count, source.core.size());
+        for (std::size_t moved = 0; moved < count;) {
+            std::size_t chunk = std::min({count - moved, target.core.back_room(), source.segment(0).size});
+            pointer from = source.slot(0);
+            pointer to = target.at_position(target.core.back_position());
+            target.core.advance_back_by(chunk);                      // Raw slots; a throw here changes nothing.
+            try {
+                relocate_contiguous(from, to, chunk, false);
+            } catch (...) {
+                target.core.retreat_back_by(chunk);                  // Give the raw slots back; both sides are as before the chunk.
+                throw;
+            }
+            source.core.drop_front(chunk);
+            moved += chunk;
         }
+        return count;
+    }
 
-        this->first_storage = new_pivot + upper_offset;
-        this->last_storage = new_pivot + lower_offset;
-        
-        for (auto& storage : new_external_storage) {                               // Выделяем кусок памяти и инициализурем сырую память значениями
-            if (storage == nullptr) {                                              // конструктора по умолчанию. Собствеенно говоря по этой причине
-                storage = this->make_storage();                                    // мы и удаляли эти 'незаполненные' стореджи(выше).
+    /*Relocates up to count elements from source's back to target's front, keeping their order; returns how many*/
+    static std::size_t move_back_to_front(Deque& source, Deque& target, std::size_t count) {
+        count = std::min(count, source.core.size());
+        for (std::size_t moved = 0; moved < count;) {
+            std::size_t last = source.segment(source.segment_count() - 1).size;
+            std::size_t chunk = std::min({count - moved, target.core.front_room(), last});
+            pointer from = source.at_position(source.core.back_position() - chunk);
+            pointer to = target.at_position(target.core.front_position() - chunk);
+            target.core.advance_front_by(chunk);
+            try {
+                relocate_contiguous(from, to, chunk, false);
+            } catch (...) {
+                target.core.drop_front(chunk);
+                throw;
             }
+            source.core.retreat_back_by(chunk);
+            moved += chunk;
         }
+        return count;
+    }
 
-        this->external_storage = new_external_storage;
-        this->external_capacity = this->external_storage.size() * this->initial_size;
+    /*First push into a moved-from deque: allocates the map and the first block, then pushes. Out of line, so the push fast path
+     * only tests the capacity*/
+    template <bool Back, typename... Args>
+    __attribute__((noinline)) reference emplace_unallocated(Args&&... args) {
+        this->core.allocate_if_needed();
+        if constexpr (Back) {
+            return this->emplace_back(std::forward<Args>(args)...);
+        } else {
+            return this->emplace_front(std::forward<Args>(args)...);
+        }
     }
 
+    /*Empty deque on `source`'s allocator, with its sizing and current block size, e.g. one that can take its blocks*/
+    explicit Deque(const DequeCore& source)
+        : core(sizeof(value_type), source.block_allocator(), source.block_sizing(), source.block_size()) {}
+
 public:
     /*=============================================================^CONSTRUCTORS_AND_DESTRUCTORS^=============================================================*/
     
-    explicit Deque() noexcept {
-        this->external_storage.resize(EXTERNAL_INIT_SIZE);
-        this->external_capacity = this->initial_size * 2;
-        this->external_storage[0] = make_storage();
-        this->external_storage[1] = make_storage();
-    }
+    explicit Deque() : core(sizeof(value_type), BoundBlockAllocator::bind<BlockAllocator>()) {}
 
-    explicit Deque(pointer source, std::size_t size) {
+    /* DequeBlockSizing::adaptive starts with small blocks and doubles them as the deque grows (see DEQUE_ADAPTIVE_*). Unlike fixed
+     * sizing and std::deque, the push, append, prepend or insert that triggers a doubling relocates every element: it invalidates
+     * all references, pointers and iterators, and that one call costs O(size()). Doublings are rare (about ten over a deque's life)
+     * and amortized O(1); use fixed sizing when references must survive pushes or push latency must stay flat*/
+    explicit Deque(DequeBlockSizing sizing) : core(sizeof(value_type), BoundBlockAllocator::bind<BlockAllocator>(), sizing) {}
+
+    explicit Deque(pointer source, std::size_t size) : Deque() {
         for (std::size_t i = 0; i < size; i++) {
             this->push_back(source[i]);
         }
     }
 
-    ~Deque() {
-        for (auto& storage : this->external_storage) {
-            delete storage;
+    /*Deep copy: blocks are owned, so sharing the map between two deques ends in a double free. The copy allocates like other*/
+    Deque(const Deque& other) : Deque(other.core) {
+        for (std::size_t i = 0; i < other.get_size(); i++) {
+            this->push_back(other[i]);
         }
     }
 
+    /*Allocates nothing: other is left empty, without map or blocks, until its next push, which allocates like before*/
+    Deque(Deque&& other) noexcept : core(sizeof(value_type), other.core.block_allocator(), DequeUnallocated()) {
+        this->swap(other);
+    }
+
+    Deque& operator=(Deque other) noexcept {
+        this->swap(other);
+        return *this;
+    }
+
+    /*The core frees the blocks afterwards*/
+    ~Deque() { this->destroy_range(0, this->core.size()); }
+
+    void swap(Deque& other) noexcept { this->core.swap(other.core); }
+
     /*========================================================================^LOOKUP^========================================================================*/
     
     /*Returns the number of elements*/
-    inline std::size_t get_size() const noexcept { return this->external_storage_size; }
+    inline std::size_t get_size() const noexcept { return this->core.size(); }
     
-    /*Returns the number of elements*/
-    inline std::size_t get_capacity() const noexcept { return this->external_storage_capacity; }
+    /*Returns the number of element slots the map can address without growing*/
+    inline std::size_t get_capacity() const noexcept { return this->core.capacity(); }
     
     /*Checks whether the container is empty*/
-    inline bool empty() const noexcept { return this->external_storage_size == 0; }
+    inline bool empty() const noexcept { return this->core.size() == 0; }
     
-    /*Acces specified element without bounds checking*/
-    reference operator[](std::size_t index) {
-        index++;
-        std::size_t offset = 0;
+    /*Returns the heap footprint split into map, live blocks and idle blocks*/
+    DequeMemoryUsage memory_usage() const noexcept { return this->core.memory_usage(); }
 
-        if (this->current_first >= this->initial_size) {
-            offset++;
-            index -= (this->initial_size - this->current_first);
-        } else {
-            index += this->current_first;
+    /*=======================================================================^SEGMENTS^=====================================================================*/
+
+    /*Position of the front element counted from the start of the first map entry, in elements*/
+    std::size_t front_position() const noexcept { return this->core.front_position(); }
+
+    /*Elements per block: DequeCore::initial_size, or the current size of an adaptive deque's blocks*/
+    std::size_t block_size() const noexcept { return this->core.block_size(); }
+
+    /*Number of blocks the elements are spread over*/
+    std::size_t segment_count() const noexcept { return this->core.segment_count(); }
+
+    /*Index of the first element of segment k*/
+    std::size_t segment_offset(std::size_t k) const noexcept { return this->core.segment_offset(k); }
+
+    /*Index of the segment holding element `index`*/
+    std::size_t segment_of(std::size_t index) const noexcept { return this->core.segment_of(index); }
+
+    /*Calls f(segment) for every segment in order, prefetching the blocks ahead. Use it for long scans instead of a segment(k) loop*/
+    template <typename F>
+    void for_each_segment(F f) {
+        std::size_t count = this->segment_count();
+        std::size_t first = this->front_position() / this->block_size();
+        for (std::size_t k = 0; k < count; k++) {
+            this->core.prefetch_block(first + k);
+            f(this->segment(k));
         }
+    }
+
+    template <typename F>
+    void for_each_segment(F f) const {
+        std::size_t count = this->segment_count();
+        std::size_t first = this->front_position() / this->block_size();
+        for (std::size_t k = 0; k < count; k++) {
+            this->core.prefetch_block(first + k);
+            f(this->segment(k));
+        }
+    }
+
+    DequeSegment<pointer> segment(std::size_t k) noexcept {
+        DequeSegment<const T*> view = static_cast<const Deque&>(*this).segment(k);
+        return {const_cast<pointer>(view.data), view.size};
+    }
 
-        offset += index / this->initial_size;
-        index %= this->initial_size;
+    DequeSegment<const T*> segment(std::size_t k) const noexcept {
+        std::size_t first = this->front_position();
+        std::size_t storage = first / this->block_size() + k;
+        std::size_t begin = std::max(first, storage * this->block_size());
+        std::size_t end = std::min(first + this->core.size(), (storage + 1) * this->block_size());
+        return {this->at_position(begin), end - begin};
+    }
 
-        return this->external_storage[this->first_storage + offset][index];
+    /*Acces specified element, bounds checked only with DEQUE_CHECKED*/
+    reference operator[](std::size_t index) {
+        return const_cast<reference>(static_cast<const Deque&>(*this)[index]);
+    }
+
+    const_reference operator[](std::size_t index) const {
+#ifdef DEQUE_CHECKED
+        this->check_index(index, "Deque::operator[]: index out of range");
+#endif
+        return *this->slot(index);
     }
     
     /*Access specified element with bounds checking*/
     reference at(std::size_t index) {
-        assert(index <= this->external_storage_size);
+        this->check_index(index, "Deque::at: index out of range");
+        return (*this)[index];
+    }
+
+    const_reference at(std::size_t index) const {
+        this->check_index(index, "Deque::at: index out of range");
         return (*this)[index];
     }
     
     /*Access the first element*/
     reference front() {
+#ifdef DEQUE_CHECKED
+        this->check_index(0, "Deque::front: deque is empty");
+#endif
         assert(!this->empty());
         return this->operator[](0);
     }
     
     /*Acces the last element*/
     reference back() {
+#ifdef DEQUE_CHECKED
+        this->check_index(0, "Deque::back: deque is empty");
+#endif
         assert(!this->empty());
-        return this->operator[](this->external_storage_size - 1);
+        return this->operator[](this->core.size() - 1);
     }
 
     /*========================================================================^METHODS^=======================================================================*/
     
     /*Inserts an element to the beginning*/
-    void push_front(const_reference source) {
-        int current_first_int = this->current_first;
+    void push_front(const_reference source) { this->emplace_front(source); }
 
-        this->external_storage[this->first_storage][this->current_first] = source;
-        this->external_storage_size++;
-        current_first_int--;
+    void push_front(value_type&& source) { this->emplace_front(std::move(source)); }
 
-        if (current_first_int < 0) {
-            this->current_first = this->initial_size - 1;
-            int first_storage_int = this->first_storage;
+    /*Adds an element to the end*/
+    void push_back(const_reference source) { this->emplace_back(source); }
 
-            if ((first_storage_int - 1) < 0) {
-                this->resize();
-            }
+    void push_back(value_type&& source) { this->emplace_back(std::move(source)); }
 
-            this->first_storage--;
-        } else {
-            this->current_first = static_cast<std::size_t>(current_first_int);
+    template <typename... Args>
+    reference emplace_front(Args&&... args) {
+        if (__builtin_expect(this->core.capacity() == 0, 0)) {
+            return this->emplace_unallocated<false>(std::forward<Args>(args)...);
         }
+        pointer target = this->at_position(this->core.front_position() - 1);
+        ::new (static_cast<void*>(target)) T(std::forward<Args>(args)...);
+        if (take_in(target, 1, [this] { return this->core.advance_front(); })) {
+            this->grow_blocks();
+            return *this->slot(0);
+        }
+        return *target;
     }
-    
-    /*Adds an element to the end*/
-    void push_back(const_reference source) {
-        int current_last_int = this->current_last;
 
-        this->external_storage[this->last_storage][this->current_last] = source;
-        this->external_storage_size++;
-        current_last_int++;
+    template <typename... Args>
+    reference emplace_back(Args&&... args) {
+        if (__builtin_expect(this->core.capacity() == 0, 0)) {
+            return this->emplace_unallocated<true>(std::forward<Args>(args)...);
+        }
+        pointer target = this->at_position(this->core.back_position());
+        ::new (static_cast<void*>(target)) T(std::forward<Args>(args)...);
+        if (take_in(target, 1, [this] { return this->core.advance_back(); })) {
+            this->grow_blocks();
+            return *this->slot(this->core.size() - 1);
+        }
+        return *target;
+    }
+
+    void pop_back() {
+        if (!this->empty()) {
+            this->core.retreat_back();
+            std::destroy_at(this->at_position(this->core.back_position()));
+        }
+    }
+                                                                    // Индекс сдвигаем так же, как и раньше, но теперь
+                                                                    // элемент еще и разрушаем: блоки - сырая память.
+    void pop_front() {
+        if (!this->empty()) {
+            std::destroy_at(this->slot(0));
+            this->core.drop_front(1);
+        }
+    }
+    
+    /*=====================================================================^BULK_METHODS^====================================================================*/
 
-        if (current_last_int >= this->initial_size) {
-            this->current_last = 0;
-            int last_storage_int = this->last_storage;
+    /*Adds count elements to the end, one block-sized copy at a time (a memmove for trivially copyable T)*/
+    void append(const T* source, std::size_t count) {
+        this->core.allocate_if_needed();
+        while (count > 0) {
+            std::size_t chunk = std::min(count, this->core.back_room());
+            pointer target = this->at_position(this->core.back_position());
+            std::uninitialized_copy(source, source + chunk, target);
+            source += chunk;
+            count -= chunk;
+            if (take_in(target, chunk, [this, chunk] { return this->core.advance_back_by(chunk); })) {
+                this->grow_blocks();
+            }
+        }
+    }
 
-            if (last_storage_int + 1 >= static_cast<int>(this->external_storage.size())) {
-                this->resize();
+    /*Adds count elements to the beginning keeping their order: source[0] becomes the front*/
+    void prepend(const T* source, std::size_t count) {
+        this->core.allocate_if_needed();
+        while (count > 0) {
+            std::size_t chunk = std::min(count, this->core.front_room());
+            pointer target = this->at_position(this->core.front_position() - chunk);
+            std::uninitialized_copy(source + count - chunk, source + count, target);
+            count -= chunk;
+            if (take_in(target, chunk, [this, chunk] { return this->core.advance_front_by(chunk); })) {
+                this->grow_blocks();
             }
+        }
+    }
 
-            this->last_storage++;
-        } else {
-            this->current_last = static_cast<std::size_t>(current_last_int);
+    /*Moves up to count elements from the front into destination; returns how many were taken*/
+    std::size_t pop_front_into(T* destination, std::size_t count) {
+        count = std::min(count, this->core.size());
+        std::size_t copied = 0;
+
+        std::size_t first = this->core.front_position() / this->block_size();
+        for (std::size_t k = 0; copied < count; k++) {
+            this->core.prefetch_block(first + k);
+            auto segment = this->segment(k);
+            std::size_t chunk = std::min(segment.size, count - copied);
+            std::move(segment.data, segment.data + chunk, destination + copied);
+            copied += chunk;
         }
+
+        this->destroy_range(0, count);
+        this->core.drop_front(count);
+        return count;
     }
 
-    void pop_back() {
-        if (!this->empty()) {
-            int current_last_int = this->current_last;
-            current_last_int--;
+    /*=====================================================================^CONTIGUOUS^======================================================================*/
+
+    /*Copies the elements in order to destination[0, size), which must hold size constructed objects. One copy per block, a memcpy
+     * for trivially copyable T. parallel_copy_to (DequeParallel.hpp) splits big copies between threads*/
+    void copy_to(T* destination) const {
+        std::size_t copied = 0;
+        this->for_each_segment([destination, &copied](DequeSegment<const T*> segment) {
+            copy_segment(segment, destination + copied);
+            copied += segment.size;
+        });
+    }
+
+    /*Copies segments [first, last) to the places copy_to puts them, destination + segment_offset(k); disjoint ranges of
+     * segments can be copied concurrently*/
+    void copy_segments_to(T* destination, std::size_t first, std::size_t last) const {
+        for (std::size_t k = first; k < last; k++) {
+            copy_segment(this->segment(k), destination + this->segment_offset(k));
+        }
+    }
 
-            if (current_last_int < 0) {
-                this->current_last = this->initial_size - 1;
-                this->last_storage--;
+    /*The elements as a std::vector, copied as by copy_to*/
+    std::vector<value_type> to_vector() const {
+        std::vector<value_type> result;
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            result.resize(this->get_size());
+            this->copy_to(result.data());
+        } else {
+            result.reserve(this->get_size());
+            this->for_each_segment(
+                [&result](DequeSegment<const T*> segment) { result.insert(result.end(), segment.begin(), segment.end()); });
+        }
+        return result;
+    }
+
+    /* Moves the elements into a single block and returns them as one segment, for handing the deque to code that wants a
+     * pointer and a length. A deque that fits in its own block and straddles two is shifted toward the front by the length of
+     * its tail; a bigger one is repacked into one freshly allocated block of at least get_size() + 2 elements, which the deque
+     * keeps, so it also grows in blocks that size afterwards. Invalidates iterators, references and pointers to the elements
+     * whenever it moves anything. Returns {nullptr, 0} for an empty deque or when the block cannot be allocated (the deque is
+     * then unchanged); an exception from T's copy constructor propagates, also leaving the deque as it was*/
+    DequeSegment<pointer> linearize() {
+        std::size_t size = this->core.size();
+        if (size == 0) {
+            return {nullptr, 0};
+        }
+        if (this->segment_count() == 1) {
+            return this->segment(0);
+        }
+        try {
+            if (size <= this->block_size() && nothrow_relocatable) {
+                this->shift_toward_front(this->segment(1).size);
             } else {
-                this->current_last = static_cast<std::size_t>(current_last_int);
+                std::size_t block = std::size_t(1) << (sizeof(unsigned long long) * 8 - __builtin_clzll(size + 1));
+                DequeCore single(sizeof(value_type), this->core.block_allocator(), this->core.block_sizing(), block);
+                single.start_at(1);                                  // Front at offset 1, so the back stays inside the block.
+                this->repack_into(single);
             }
-
-            this->external_storage_size--;
+        } catch (const std::bad_alloc&) {
+            return {nullptr, 0};
         }
+        return this->segment(0);
     }
-                                                                    // По факту элемент в этих методах мы никак не удаляем,
-                                                                    // да по сути эффективно удалить и не можем, поэтому наша
-                                                                    // задача - просто правильно поддерживать индекс.
-    void pop_front() {
-        if (!this->empty()) {
-            int current_first_int = this->current_first;
-            current_first_int++;
 
-            if (current_first_int >= this->initial_size) {
-                this->current_first = 0;
-                this->first_storage++;
+    /*=======================================================================^SPLICING^======================================================================*/
+
+    /* Wherever the in-block offsets line up these move whole blocks by pointer, and relocate elements (memmove for trivially
+     * relocatable T) only at the partial edge blocks. When two deques' offsets differ, the smaller one is shifted into line
+     * first, which moves each of its elements once. */
+
+    /*Rotates left like std::rotate(begin(), begin() + k, end()): element k becomes the front. When the size is a multiple of
+     * block_size() the middle of the rotation is whole blocks, O(k / block_size() + block_size()); otherwise it relocates
+     * min(k, size - k) elements*/
+    void rotate(std::size_t k) {
+        std::size_t size = this->core.size();
+        if (size == 0 || k % size == 0) {
+            return;
+        }
+        k %= size;
+        if (size % this->block_size() != 0) {
+            if (k <= size - k) {
+                move_front_to_back(*this, *this, k);
             } else {
-                this->current_first = static_cast<std::size_t>(current_first_int);
+                move_back_to_front(*this, *this, size - k);
             }
+            return;
+        }
+
+        std::size_t edge = std::min(k, (this->block_size() - this->core.front_position() % this->block_size()) % this->block_size());
+        move_front_to_back(*this, *this, edge);                      // Front and back now both on a block boundary.
+        std::size_t blocks = (k - edge) / this->block_size();
+        this->core.move_front_blocks_to_back(blocks);
+        move_front_to_back(*this, *this, k - edge - blocks * this->block_size());
+    }
 
-            this->external_storage_size--;
+    /* Appends other's elements, leaving other empty. O(blocks) when this back and other's front have the same in-block offset and
+     * both deques allocate from the same place (for ArenaDeque, the same arena); otherwise the elements are relocated*/
+    void splice_back(Deque&& other) {
+        if (&other == this || other.empty()) {
+            return;
+        }
+        if (this->core.block_allocator() != other.core.block_allocator()) {  // Blocks stay with the arena they came from.
+            this->core.allocate_if_needed();
+            move_front_to_back(other, *this, other.get_size());
+            return;
+        }
+        if (this->empty()) {
+            this->swap(other);
+            return;
+        }
+        if (this->block_size() != other.block_size() || !nothrow_relocatable) {  // Different block sizes share no offsets.
+            move_front_to_back(other, *this, other.get_size());
+            return;
+        }
+        std::size_t back = this->core.back_position() % this->block_size();
+        std::size_t front = other.core.front_position() % this->block_size();
+        if (back != front) {
+            if (this->get_size() <= other.get_size()) {
+                this->shift_toward_front((back + this->block_size() - front) % this->block_size());
+            } else {
+                other.shift_toward_front((front + this->block_size() - back) % this->block_size());
+            }
+        }
+        move_front_to_back(other, *this, (this->block_size() - this->core.back_position() % this->block_size()) % this->block_size());
+        if (!other.empty()) {
+            this->core.splice_back(other.core);
         }
     }
-    
-    void print_deque() {
-        for (auto& storage : this->external_storage) {
-            for (std::size_t i = 0; i < this->initial_size; i++) {
-                std::cout << storage[i] << " ";
+
+    /*Prepends other's elements in their order, leaving other empty. O(blocks) when this front and other's back line up*/
+    void splice_front(Deque&& other) {
+        if (&other == this || other.empty()) {
+            return;
+        }
+        if (this->core.block_allocator() != other.core.block_allocator()) {
+            this->core.allocate_if_needed();
+            move_back_to_front(other, *this, other.get_size());
+            return;
+        }
+        if (this->empty()) {
+            this->swap(other);
+            return;
+        }
+        if (this->block_size() != other.block_size() || !nothrow_relocatable) {
+            move_back_to_front(other, *this, other.get_size());
+            return;
+        }
+        std::size_t front = this->core.front_position() % this->block_size();
+        std::size_t back = other.core.back_position() % this->block_size();
+        if (front != back) {
+            if (this->get_size() <= other.get_size()) {
+                this->shift_toward_front((front + this->block_size() - back) % this->block_size());
+            } else {
+                other.shift_toward_front((back + this->block_size() - front) % this->block_size());
             }
-            std::cout << std::endl;
         }
-        std::cout << "\n\n\n\n";
+        move_back_to_front(other, *this, this->core.front_position() % this->block_size());
+        if (!other.empty()) {
+            this->core.splice_front(other.core);
+        }
+    }
+
+    /*Moves elements [pos, size) into a new deque and returns it. The blocks from the one holding pos on change owner by pointer;
+     * only this side's elements that share that block are relocated. Throws std::out_of_range past the end*/
+    Deque split_at(std::size_t pos) {
+        std::size_t size = this->core.size();
+        if (pos > size) {
+            throw std::out_of_range("Deque::split_at: position out of range");
+        }
+        Deque tail(this->core);
+        if (pos == 0) {
+            tail.swap(*this);
+        }
+        if (pos == 0 || pos == size) {
+            return tail;
+        }
+        if (!nothrow_relocatable) {
+            move_back_to_front(*this, tail, size - pos);
+            return tail;
+        }
+
+        std::size_t position = this->core.front_position() + pos;
+        std::size_t first = std::max(this->core.front_position(), position - position % this->block_size());
+        this->core.split_back(tail.core, position);
+        pointer source = static_cast<pointer>(tail.core.block(tail.core.front_position() / this->block_size()));
+        relocate_contiguous(source + first % this->block_size(), this->at_position(first), position - first, false);
+        return tail;
+    }
+
+    /*Removes every element; the blocks stay allocated for reuse*/
+    void clear() noexcept {
+        this->destroy_range(0, this->core.size());
+        this->core.drop_front(this->core.size());
     }
 
+    /*Releases the idle blocks; the map itself keeps its size*/
+    void shrink_to_fit() noexcept { this->core.shrink_to_fit(); }
+
     /*======================================================================^ITERATOR^=======================================================================*/
     
-    class Iterator {
+    /* Random access iterator over indices counted from the front, in a mutable and a const flavour. It is a legacy random access
+     * iterator for C++17 algorithms and a std::random_access_iterator for ranges. Every insertion or removal invalidates it, which
+     * DEQUE_CHECKED builds detect on use*/
+    template <bool Const>
+    class BasicIterator {
         friend class Deque;
+        template <bool>
+        friend class BasicIterator;
+
+        typedef typename std::conditional<Const, const Deque*, Deque*>::type owner_pointer;
 
     private:
+        owner_pointer deque;
         std::size_t current_position;
-        Deque<T> *deque;
+#ifdef DEQUE_CHECKED
+        std::size_t generation = 0;
+#endif
+
+        /*Throws if the deque changed since the iterator was made, or if it does not point before `limit`*/
+        void validate([[maybe_unused]] const Deque* owner, [[maybe_unused]] std::size_t limit) const {
+#ifdef DEQUE_CHECKED
+            if (this->deque == nullptr || this->deque != owner || this->generation != this->deque->core.generation()) {
+                throw std::logic_error("Deque::Iterator: iterator is invalidated or belongs to another deque");
+            }
+            if (this->current_position >= limit) {
+                throw std::out_of_range("Deque::Iterator: position out of range");
+            }
+#endif
+        }
 
     public:
         using iterator_category = std::random_access_iterator_tag;
-        using value_type = T;
-        using pointer = T*;
-        using reference = T&;
+        using iterator_concept = std::random_access_iterator_tag;
+        using value_type = typename std::remove_cv<T>::type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<Const, const T*, T*>::type;
+        using reference = typename std::conditional<Const, const T&, T&>::type;
 
-        Iterator() : deque(nullptr), current_position(0) {}
-        Iterator(Deque<T> *_deque, std::size_t position) : deque(_deque), current_position(position) {}
+        BasicIterator() : deque(nullptr), current_position(0) {}
+        BasicIterator(owner_pointer _deque, std::size_t position) : deque(_deque), current_position(position) {
+#ifdef DEQUE_CHECKED
+            this->generation = _deque->core.generation();
+#endif
+        }
 
-        Iterator &operator=(const Iterator &other) {
-            this->current_position = other.current_position;
-            this->deque = other.deque;
-            return *this;
+        /*iterator converts to const_iterator, not the other way round*/
+        template <bool OtherConst, typename = typename std::enable_if<Const && !OtherConst>::type>
+        BasicIterator(const BasicIterator<OtherConst>& other) : deque(other.deque), current_position(other.current_position) {
+#ifdef DEQUE_CHECKED
+            this->generation = other.generation;
+#endif
+        }
+
+        reference operator*() const {
+            this->validate(this->deque, this->deque->get_size());
+            return (*this->deque)[this->current_position];
         }
 
-        Iterator &operator+=(const std::size_t &offset) {
-            *this = (*this).operator+(offset);
+        pointer operator->() const { return std::addressof(**this); }
+
+        reference operator[](difference_type offset) const { return *(*this + offset); }
+
+        BasicIterator &operator++() {
+            this->current_position++;
+            this->deque->prefetch_ahead(this->current_position);
             return *this;
         }
 
-        Iterator &operator-=(const std::size_t &offset) {
-            *this = (*this).operator-(offset);
+        BasicIterator operator++(int) {
+            BasicIterator result = *this;
+            ++*this;
+            return result;
+        }
+
+        BasicIterator &operator--() {
+            this->current_position--;
             return *this;
         }
 
-        Iterator operator+(const std::size_t &offset) {
-            return Iterator(this->deque, this->current_position + offset);
+        BasicIterator operator--(int) {
+            BasicIterator result = *this;
+            this->current_position--;
+            return result;
         }
 
-        Iterator operator-(const std::size_t &offset) {
-            return Iterator(this->deque, this->current_position - offset);
+        BasicIterator &operator+=(difference_type offset) {
+            this->current_position += offset;                       // Copies keep the generation of the original.
+            return *this;
         }
 
-        T& operator*() const {
-            return (*deque)[current_position];
+        BasicIterator &operator-=(difference_type offset) {
+            this->current_position -= offset;
+            return *this;
         }
-        
-        Iterator &operator++() {
-            return (*this).operator+=(1);
+
+        BasicIterator operator+(difference_type offset) const {
+            BasicIterator result = *this;
+            return result += offset;
         }
 
-        Iterator &operator--() {
-            return (*this).operator-=(1);
+        BasicIterator operator-(difference_type offset) const {
+            BasicIterator result = *this;
+            return result -= offset;
         }
 
-        bool operator==(const Iterator &other) {
-            return (this->deque == other.deque) && (this->current_position == other.current_position);
+        friend BasicIterator operator+(difference_type offset, const BasicIterator &it) { return it + offset; }
+
+        friend difference_type operator-(const BasicIterator &lhs, const BasicIterator &rhs) {
+            return static_cast<difference_type>(lhs.current_position - rhs.current_position);
         }
 
-        bool operator!=(const Iterator &other) {
-            return (this->deque != other.deque) || (this->current_position != other.current_position);
+        friend bool operator==(const BasicIterator &lhs, const BasicIterator &rhs) {
+            return lhs.deque == rhs.deque && lhs.current_position == rhs.current_position;
         }
+
+        friend bool operator!=(const BasicIterator &lhs, const BasicIterator &rhs) { return !(lhs == rhs); }
+
+        friend bool operator<(const BasicIterator &lhs, const BasicIterator &rhs) { return lhs.current_position < rhs.current_position; }
+
+        friend bool operator>(const BasicIterator &lhs, const BasicIterator &rhs) { return rhs < lhs; }
+
+        friend bool operator<=(const BasicIterator &lhs, const BasicIterator &rhs) { return !(rhs < lhs); }
+
+        friend bool operator>=(const BasicIterator &lhs, const BasicIterator &rhs) { return !(lhs < rhs); }
     };
 
-    using iterator = Iterator;
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+    using Iterator = iterator;
 
-    Iterator begin() {
-        return Iterator(this, 0);
-    }
+    iterator begin() { return iterator(this, 0); }
 
-    Iterator end() {
-        return Iterator(this, this->get_size());
-    }
+    iterator end() { return iterator(this, this->get_size()); }
 
-    /*======================================================================^STREAM^=======================================================================*/
+    const_iterator begin() const { return const_iterator(this, 0); }
 
-    friend std::ostream &operator<<(std::ostream& out, Deque<T>* source) noexcept {
-        if (source == NULL) {
-            return out;
-        }
+    const_iterator end() const { return const_iterator(this, this->get_size()); }
 
-        for (auto it = source->begin(); it != source->end(); it.operator++()) {
-            out << it.operator*() << " ";
-        }
-        out << std::endl;
+    const_iterator cbegin() const { return this->begin(); }
 
-        return out;
-    }
+    const_iterator cend() const { return this->end(); }
+
+    /*The blocks as a range of contiguous DequeSegment views: for (auto segment : deque.segments()) ...*/
+    DequeSegmentView<Deque, pointer> segments() noexcept { return DequeSegmentView<Deque, pointer>(this); }
+
+    DequeSegmentView<const Deque, const T*> segments() const noexcept { return DequeSegmentView<const Deque, const T*>(this); }
+
+    /*Inserts before `it`, relocating whichever side of the insertion point is shorter (memmove for trivially relocatable T)*/
+    void insert(iterator it, const T& source) { this->insert(it, T(source)); }  // source may live in the range we shift
 
-    void insert(iterator it, const T& source) {
-        if (it == this->end()) {
-            this->push_back(source);
+    void insert(iterator it, T&& source) {
+        it.validate(this, this->get_size() + 1);
+        if constexpr (!std::is_nothrow_move_constructible<T>::value) {
+            this->insert_by_assignment(it.current_position, std::move(source));
         } else {
-            T copy = it.operator*();
-            it.operator*() = source;
+            this->core.allocate_if_needed();
+            std::size_t index = it.current_position;
+            std::size_t size = this->get_size();
 
-            for (auto deque_iterator = it.operator++(); deque_iterator != this->end(); deque_iterator.operator++()) {
-                T buffer = deque_iterator.operator*();
-                deque_iterator.operator*() = copy;
-                copy = buffer;
+            bool grow;
+            if (index < size - index) {
+                grow = this->core.advance_front();                  // Raw slot at 0, the old elements now sit at [1, size].
+                this->relocate(1, 0, index);
+            } else {
+                grow = this->core.advance_back();                   // Raw slot at size.
+                this->relocate(index, index + 1, size - index);
             }
 
-            this->push_back(copy);
+            ::new (static_cast<void*>(this->slot(index))) T(std::move(source));
+            if (grow) {
+                this->grow_blocks();
+            }
         }
     }
 
+    /*Erases the element at `it`, relocating whichever side is shorter*/
     void erase(iterator it) {
-        for (auto deque_iterator = it; deque_iterator != this->end(); deque_iterator.operator++()) {
-            *(deque_iterator - 1) = *(deque_iterator);
+        it.validate(this, this->get_size());
+        std::size_t index = it.current_position;
+        std::size_t size = this->get_size();
+
+        if constexpr (!nothrow_relocatable) {
+            if (index < size - index - 1) {
+                std::move_backward(this->begin(), this->begin() + index, this->begin() + index + 1);
+                this->pop_front();
+            } else {
+                std::move(this->begin() + index + 1, this->end(), this->begin() + index);
+                this->pop_back();
+            }
+        } else {
+            std::destroy_at(this->slot(index));
+            if (index < size - index - 1) {
+                this->relocate(0, 1, index);
+                this->core.drop_front(1);
+            } else {
+                this->relocate(index + 1, index, size - index - 1);
+                this->core.retreat_back();
+            }
         }
+    }
 
-        this->pop_back();
+private:
+    /*insert for T whose move can throw, the way std::deque does it: a copy of the end element is pushed on the shorter side, the
+     * elements up to `index` are shifted over by assignment and the new value assigned into place. A throw from the push leaves
+     * the deque as it was; one from an assignment leaves every element valid*/
+    void insert_by_assignment(std::size_t index, T&& source) {
+        std::size_t size = this->get_size();
+        if (index == 0) {
+            this->emplace_front(std::move(source));
+        } else if (index == size) {
+            this->emplace_back(std::move(source));
+        } else if (index < size - index) {
+            this->emplace_front(std::move_if_noexcept(this->front()));
+            std::move(this->begin() + 2, this->begin() + index + 1, this->begin() + 1);
+            (*this)[index] = std::move(source);
+        } else {
+            this->emplace_back(std::move_if_noexcept(this->back()));
+            std::move_backward(this->begin() + index, this->begin() + size - 1, this->begin() + size);
+            (*this)[index] = std::move(source);
+        }
     }
 };
 
+/*Segments and their view only point into the deque: cheap to copy, and their iterators outlive them*/
+#if defined(__cpp_lib_ranges)
+template <typename Pointer>
+inline constexpr bool std::ranges::enable_view<DequeSegment<Pointer>> = true;
+template <typename Pointer>
+inline constexpr bool std::ranges::enable_borrowed_range<DequeSegment<Pointer>> = true;
+template <typename Owner, typename Pointer>
+inline constexpr bool std::ranges::enable_view<DequeSegmentView<Owner, Pointer>> = true;
+template <typename Owner, typename Pointer>
+inline constexpr bool std::ranges::enable_borrowed_range<DequeSegmentView<Owner, Pointer>> = true;
+#endif
+
+#include "DequeBool.hpp"                                            // Bit-packed Deque<bool>.
+
 #endif // SRC_DEQUE_HPP_
@@ -0,0 +1,266 @@
+#ifndef SRC_DEQUE_BOOL_HPP_
+#define SRC_DEQUE_BOOL_HPP_
+
+#include <cassert>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "Deque.hpp"
+
+/*count() sums popcounts over whole blocks of words. On x86-64 Linux the loop is compiled three times and the loader picks one
+ * for the CPU: AVX-512 VPOPCNTQ (vectorized at -O3), scalar POPCNT, or the portable fallback*/
+#if defined(__x86_64__) && defined(__linux__) && defined(__GNUC__) && !defined(__clang__)
+#define DEQUE_POPCOUNT_CLONES __attribute__((target_clones("arch=icelake-server", "popcnt", "default")))
+#else
+#define DEQUE_POPCOUNT_CLONES
+#endif
+
+DEQUE_POPCOUNT_CLONES
+inline std::size_t deque_popcount(const uint64_t* words, std::size_t count) noexcept {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        total += static_cast<std::size_t>(__builtin_popcountll(words[i]));
+    }
+    return total;
+}
+
+/* Bit-packed Deque<bool>: 64 flags per word, the words kept in a Deque<uint64_t> with the same block allocator, so a block of
+ * 64 words holds 4096 flags instead of 64. Bit i lives at global bit first_bit + i of the word sequence, bit 0 of a word first.
+ * Bits outside [first_bit, first_bit + size) are kept zero, which lets count() popcount whole blocks without masking.
+ *
+ * Like std::vector<bool> there are no bool& references: read with operator[] and write with set(). The *_bits methods move up
+ * to 64 flags at once with a couple of shifts.*/
+template <typename BlockAllocator>
+class Deque<bool, BlockAllocator> {
+private:
+    const static std::size_t word_bits = 64;
+
+    Deque<uint64_t, BlockAllocator> words;
+    std::size_t first_bit = 0;                                       // Offset of the front flag in words[0], < word_bits.
+    std::size_t bit_count = 0;
+
+    static uint64_t low_mask(std::size_t count) noexcept {
+        return count >= word_bits ? ~uint64_t(0) : (uint64_t(1) << count) - 1;
+    }
+
+    void check_index(std::size_t index, const char* message) const {
+        if (index >= this->bit_count) {
+            throw std::out_of_range(message);
+        }
+    }
+
+    /*An empty deque owns no words and starts at bit 0 again, so push_front and push_back both have room to grow*/
+    void reset_if_empty() noexcept {
+        if (this->bit_count == 0) {
+            this->words.clear();
+            this->first_bit = 0;
+        }
+    }
+
+public:
+    /*=============================================================^CONSTRUCTORS_AND_DESTRUCTORS^=============================================================*/
+
+    explicit Deque() = default;
+
+    Deque(const Deque& other) = default;
+
+    Deque(Deque&& other) noexcept : words(std::move(other.words)), first_bit(other.first_bit), bit_count(other.bit_count) {
+        other.first_bit = 0;
+        other.bit_count = 0;
+    }
+
+    Deque& operator=(Deque other) noexcept {
+        this->swap(other);
+        return *this;
+    }
+
+    void swap(Deque& other) noexcept {
+        this->words.swap(other.words);
+        std::swap(this->first_bit, other.first_bit);
+        std::swap(this->bit_count, other.bit_count);
+    }
+
+    /*========================================================================^LOOKUP^========================================================================*/
+
+    /*Returns the number of flags*/
+    inline std::size_t get_size() const noexcept { return this->bit_count; }
+
+    /*Returns the number of flags the map can address without growing*/
+    inline std::size_t get_capacity() const noexcept { return this->words.get_capacity() * word_bits; }
+
+    inline bool empty() const noexcept { return this->bit_count == 0; }
+
+    DequeMemoryUsage memory_usage() const noexcept { return this->words.memory_usage(); }
+
+    /*Number of set flags*/
+    std::size_t count() const noexcept {
+        std::size_t total = 0;
+        this->words.for_each_segment([&total](DequeSegment<const uint64_t*> segment) {
+            total += deque_popcount(segment.data, segment.size);
+        });
+        return total;
+    }
+
+    /*Reads flag `index`, bounds checked only with DEQUE_CHECKED*/
+    bool operator[](std::size_t index) const {
+#ifdef DEQUE_CHECKED
+        this->check_index(index, "Deque<bool>::operator[]: index out of range");
+#endif
+        std::size_t bit = this->first_bit + index;
+        return (this->words[bit / word_bits] >> (bit % word_bits)) & 1;
+    }
+
+    bool at(std::size_t index) const {
+        this->check_index(index, "Deque<bool>::at: index out of range");
+        return (*this)[index];
+    }
+
+    bool front() const {
+#ifdef DEQUE_CHECKED
+        this->check_index(0, "Deque<bool>::front: deque is empty");
+#endif
+        assert(!this->empty());
+        return (*this)[0];
+    }
+
+    bool back() const {
+#ifdef DEQUE_CHECKED
+        this->check_index(0, "Deque<bool>::back: deque is empty");
+#endif
+        assert(!this->empty());
+        return (*this)[this->bit_count - 1];
+    }
+
+    /*Writes flag `index`, bounds checked only with DEQUE_CHECKED*/
+    void set(std::size_t index, bool value) {
+#ifdef DEQUE_CHECKED
+        this->check_index(index, "Deque<bool>::set: index out of range");
+#endif
+        std::size_t bit = this->first_bit + index;
+        uint64_t& word = this->words[bit / word_bits];
+        uint64_t mask = uint64_t(1) << (bit % word_bits);
+        word = value ? (word | mask) : (word & ~mask);
+    }
+
+    /*========================================================================^METHODS^=======================================================================*/
+
+    void push_back(bool value) { this->push_back_bits(value, 1); }
+
+    void push_front(bool value) { this->push_front_bits(value, 1); }
+
+    void pop_back() {
+        if (!this->empty()) {
+            this->pop_back_bits(1);
+        }
+    }
+
+    void pop_front() {
+        if (!this->empty()) {
+            this->pop_front_bits(1);
+        }
+    }
+
+    /*Removes every flag; the blocks stay allocated for reuse*/
+    void clear() noexcept {
+        this->bit_count = 0;
+        this->reset_if_empty();
+    }
+
+    void shrink_to_fit() noexcept { this->words.shrink_to_fit(); }
+
+    /*=====================================================================^BULK_METHODS^====================================================================*/
+
+    /*Adds the low `count` (<= 64) bits of `bits` to the end, bit 0 first*/
+    void push_back_bits(uint64_t bits, std::size_t count) {
+        assert(count <= word_bits);
+        if (count == 0) {
+            return;
+        }
+        bits &= low_mask(count);
+        std::size_t offset = (this->first_bit + this->bit_count) % word_bits;
+        if (offset == 0) {
+            this->words.push_back(bits);
+        } else {
+            this->words.back() |= bits << offset;
+            if (offset + count > word_bits) {
+                this->words.push_back(bits >> (word_bits - offset));
+            }
+        }
+        this->bit_count += count;
+    }
+
+    /*Adds the low `count` (<= 64) bits of `bits` to the beginning keeping their order: bit 0 becomes the front*/
+    void push_front_bits(uint64_t bits, std::size_t count) {
+        assert(count <= word_bits);
+        if (count == 0) {
+            return;
+        }
+        bits &= low_mask(count);
+        if (this->first_bit >= count) {
+            this->first_bit -= count;
+            this->words.front() |= bits << this->first_bit;
+        } else {
+            std::size_t first = this->first_bit + word_bits - count;  // Front offset inside the new word.
+            if (this->first_bit > 0) {
+                this->words.front() |= bits >> (word_bits - first);
+            }
+            this->words.push_front(bits << first);
+            this->first_bit = first;
+        }
+        this->bit_count += count;
+    }
+
+    /*Removes `count` (<= 64, <= size) flags from the front and returns them, the former front in bit 0*/
+    uint64_t pop_front_bits(std::size_t count) {
+        assert(count <= word_bits && count <= this->bit_count);
+        if (count == 0) {
+            return 0;
+        }
+        uint64_t bits = this->words.front() >> this->first_bit;
+        if (this->first_bit + count > word_bits) {
+            bits |= this->words[1] << (word_bits - this->first_bit);
+        }
+        bits &= low_mask(count);
+
+        this->first_bit += count;
+        this->bit_count -= count;
+        if (this->first_bit >= word_bits) {
+            this->words.pop_front();
+            this->first_bit -= word_bits;
+        }
+        if (this->bit_count > 0) {
+            this->words.front() &= ~low_mask(this->first_bit);
+        }
+        this->reset_if_empty();
+        return bits;
+    }
+
+    /*Removes `count` (<= 64, <= size) flags from the end and returns them in order, the new back's successor in bit 0*/
+    uint64_t pop_back_bits(std::size_t count) {
+        assert(count <= word_bits && count <= this->bit_count);
+        if (count == 0) {
+            return 0;
+        }
+        std::size_t end = this->first_bit + this->bit_count - count;
+        std::size_t offset = end % word_bits;
+        uint64_t bits = this->words[end / word_bits] >> offset;
+        if (offset + count > word_bits) {
+            bits |= this->words[end / word_bits + 1] << (word_bits - offset);
+        }
+        bits &= low_mask(count);
+
+        this->bit_count -= count;
+        std::size_t word_count = (end + word_bits - 1) / word_bits;
+        while (this->words.get_size() > word_count) {
+            this->words.pop_back();
+        }
+        if (offset != 0) {
+            this->words.back() &= low_mask(offset);
+        }
+        this->reset_if_empty();
+        return bits;
+    }
+};
+
+#endif  // SRC_DEQUE_BOOL_HPP_
@@ -0,0 +1,635 @@
+#ifndef SRC_DEQUE_CORE_HPP_
+#define SRC_DEQUE_CORE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "BlockAllocator.hpp"
+
+#define EXTERNAL_INIT_SIZE 2
+
+/*Software prefetch for scans: entering block b, Iterator::operator++ and for_each_segment request block b + DISTANCE (its first
+ * LINES cache lines) and the map entry after it. The next block is a fresh pointer chase the hardware prefetcher cannot follow.
+ * DISTANCE 0 turns it off.*/
+#ifndef DEQUE_PREFETCH_DISTANCE
+#define DEQUE_PREFETCH_DISTANCE 2
+#endif
+#ifndef DEQUE_PREFETCH_LINES
+#define DEQUE_PREFETCH_LINES 4
+#endif
+
+/*Adaptive block sizing (DequeBlockSizing::adaptive): blocks start at 1 << MIN_SHIFT elements and double, by repacking the
+ * elements, once the deque holds GROWTH_BLOCKS blocks' worth, up to MAX_BLOCK_BYTES per block*/
+#ifndef DEQUE_ADAPTIVE_MIN_SHIFT
+#define DEQUE_ADAPTIVE_MIN_SHIFT 4
+#endif
+#ifndef DEQUE_ADAPTIVE_GROWTH_BLOCKS
+#define DEQUE_ADAPTIVE_GROWTH_BLOCKS 32
+#endif
+#ifndef DEQUE_ADAPTIVE_MAX_BLOCK_BYTES
+#define DEQUE_ADAPTIVE_MAX_BLOCK_BYTES (std::size_t(64) << 10)
+#endif
+
+/*fixed: every block holds DequeCore::initial_size elements. adaptive: the block size grows with the deque, see above*/
+enum class DequeBlockSizing { fixed, adaptive };
+
+/*Tag for a core without map and blocks, the state a moved-from deque is left in. The first push allocates them*/
+struct DequeUnallocated {};
+
+/*Heap bytes owned by a deque. Live blocks hold at least one element slot between the first and the last element, idle blocks
+ * are allocated but currently empty (left behind by pop_* or parked by resize for reuse)*/
+struct DequeMemoryUsage {
+    std::size_t map_bytes = 0;
+    std::size_t live_block_bytes = 0;
+    std::size_t idle_block_bytes = 0;
+
+    std::size_t total() const noexcept { return this->map_bytes + this->live_block_bytes + this->idle_block_bytes; }
+};
+
+/*A block allocation policy with the type erased: its static functions by address, all taking the context*/
+struct BlockAllocatorOps {
+    void* (*context)();
+    void* (*allocate)(void* context, std::size_t bytes);
+    void (*deallocate)(void* context, void* storage, std::size_t bytes) noexcept;
+};
+
+/*Whether a policy takes a context, see BlockAllocator.hpp*/
+template <typename Policy, typename = void>
+struct block_allocator_has_context : std::false_type {};
+
+template <typename Policy>
+struct block_allocator_has_context<Policy, std::void_t<decltype(Policy::context())>> : std::true_type {};
+
+/*Gives a policy without a context the signatures of one with*/
+template <typename Policy, bool = block_allocator_has_context<Policy>::value>
+struct BlockAllocatorAdapter : Policy {};
+
+template <typename Policy>
+struct BlockAllocatorAdapter<Policy, false> {
+    static void* context() noexcept { return nullptr; }
+    static void* allocate(void*, std::size_t bytes) { return Policy::allocate(bytes); }
+    static void deallocate(void*, void* storage, std::size_t bytes) noexcept { Policy::deallocate(storage, bytes); }
+};
+
+template <typename Policy>
+inline constexpr BlockAllocatorOps block_allocator_ops = {
+    &BlockAllocatorAdapter<Policy>::context, &BlockAllocatorAdapter<Policy>::allocate, &BlockAllocatorAdapter<Policy>::deallocate};
+
+/*A policy bound to one deque: the policy and the context it returned when the deque was constructed*/
+struct BoundBlockAllocator {
+    const BlockAllocatorOps* ops;
+    void* context;
+
+    template <typename Policy>
+    static BoundBlockAllocator bind() {
+        return {&block_allocator_ops<Policy>, block_allocator_ops<Policy>.context()};
+    }
+
+    void* allocate(std::size_t bytes) const { return this->ops->allocate(this->context, bytes); }
+    void deallocate(void* storage, std::size_t bytes) const noexcept { this->ops->deallocate(this->context, storage, bytes); }
+
+    bool operator==(const BoundBlockAllocator& other) const noexcept { return this->ops == other.ops && this->context == other.context; }
+    bool operator!=(const BoundBlockAllocator& other) const noexcept { return !(*this == other); }
+};
+
+/*std allocator for the map vector, forwarding to the deque's policy*/
+template <typename U>
+struct MapAllocator {
+    using value_type = U;
+    using propagate_on_container_swap = std::true_type;
+
+    BoundBlockAllocator blocks;
+
+    explicit MapAllocator(const BoundBlockAllocator& _blocks) noexcept : blocks(_blocks) {}
+    template <typename V>
+    MapAllocator(const MapAllocator<V>& other) noexcept : blocks(other.blocks) {}
+
+    U* allocate(std::size_t n) { return static_cast<U*>(this->blocks.allocate(n * sizeof(U))); }
+    void deallocate(U* storage, std::size_t n) noexcept { this->blocks.deallocate(storage, n * sizeof(U)); }
+
+    template <typename V>
+    bool operator==(const MapAllocator<V>& other) const noexcept { return this->blocks == other.blocks; }
+    template <typename V>
+    bool operator!=(const MapAllocator<V>& other) const noexcept { return this->blocks != other.blocks; }
+};
+                                                                       /*
+                                                                     |  *                        *[] -> nullptr
+                                                                     |  *                        *[] -> nullptr
+             Data structure                                          |  * first_storage          *[] -> [uninit_zone ... value[current_first] ... values]
+             organization                                            |  *                        *[] -> [       ...      values          ...            ]
+                                                                     |  *                        *[] -> [       ...      values          ...            ]
+The reasion to use vector as external storage instead of list is     |  * last_storage           *[] -> [values ... value[current_last] ... uninit_zone]
+a random acces iterator category. Using list will give asymptotic    |  *                        *[] -> nullptr
+of basic operations better, but using vector gives us the same       |  *
+amortization time that we can have with using list.                  |  *   external_storage_size = 4 * initial_size - uninit_zone
+                                                                     |  *   external_capacity = external_storage.size() * initial_size
+                                                                     |  *
+                                                                        */
+/* The element-agnostic half of Deque: the map, the block indices and block allocation, parameterized by the element size at run
+ * time. Every Deque<T> instantiation shares this one copy instead of stamping out its own index logic; the typed wrapper only
+ * constructs, destroys and moves elements in the slots the core hands out. The core never touches element objects, so the
+ * wrapper destroys them before the core frees the blocks.
+ *
+ * Positions count element slots from the start of external_storage[0]: slot p lives in block p / block_size() at offset
+ * p % block_size(). A fixed core keeps blocks of initial_size elements; an adaptive one starts smaller and, when its
+ * advance_* reports that the deque outgrew the blocks, the wrapper repacks the elements into a core with blocks twice as large.
+ * The members are defined in the class body, so they are inline and the linker folds them across translation units as well. */
+class DequeCore {
+public:
+    const static std::size_t initial_shift = 6;
+    const static std::size_t initial_size = std::size_t(1) << initial_shift;   // Elements per block of a fixed core.
+
+    /*block_size (a power of two) overrides the starting block size of the sizing mode*/
+    DequeCore(std::size_t _element_size, const BoundBlockAllocator& _allocator, DequeBlockSizing _sizing = DequeBlockSizing::fixed,
+              std::size_t _block_size = 0)
+        : element_size(_element_size),
+          allocator(_allocator),
+          sizing(_sizing),
+          block_shift(_block_size != 0                           ? log2_of(_block_size)
+                      : _sizing == DequeBlockSizing::fixed ? initial_shift
+                                                           : DEQUE_ADAPTIVE_MIN_SHIFT),
+          external_storage(MapAllocator<void*>(_allocator)) {
+        this->allocate_map();
+    }
+
+    /*Empty fixed core that allocates nothing until allocate_if_needed(); cannot throw*/
+    DequeCore(std::size_t _element_size, const BoundBlockAllocator& _allocator, DequeUnallocated) noexcept
+        : element_size(_element_size),
+          allocator(_allocator),
+          sizing(DequeBlockSizing::fixed),
+          block_shift(initial_shift),
+          external_storage(MapAllocator<void*>(_allocator)) {}
+
+    DequeCore(const DequeCore&) = delete;
+    DequeCore& operator=(const DequeCore&) = delete;
+
+    ~DequeCore() {
+        for (auto& storage : this->external_storage) {
+            this->free_storage(storage);
+        }
+    }
+
+    void swap(DequeCore& other) noexcept {
+        std::swap(this->current_first, other.current_first);
+        std::swap(this->current_last, other.current_last);
+        std::swap(this->first_storage, other.first_storage);
+        std::swap(this->last_storage, other.last_storage);
+        std::swap(this->external_storage_size, other.external_storage_size);
+        std::swap(this->external_capacity, other.external_capacity);
+        std::swap(this->sizing, other.sizing);
+        std::swap(this->block_shift, other.block_shift);
+        std::swap(this->grow_size, other.grow_size);
+        std::swap(this->allocator, other.allocator);
+        this->external_storage.swap(other.external_storage);
+        this->invalidate_iterators();
+        other.invalidate_iterators();
+    }
+
+    /*Gives an unallocated core its map and the block under the first and last element; a no-op once it has them. Every path
+     * that constructs elements calls it first, or tests capacity() == 0 itself*/
+    void allocate_if_needed() {
+        if (__builtin_expect(this->external_capacity == 0, 0)) {
+            this->allocate_map();
+        }
+    }
+
+    /*========================================================================^LOOKUP^========================================================================*/
+
+    std::size_t size() const noexcept { return this->external_storage_size; }
+
+    /*Elements per block*/
+    std::size_t block_size() const noexcept { return std::size_t(1) << this->block_shift; }
+
+    DequeBlockSizing block_sizing() const noexcept { return this->sizing; }
+
+    /*The policy and context this core's blocks come from*/
+    const BoundBlockAllocator& block_allocator() const noexcept { return this->allocator; }
+
+    /*Block size an adaptive core repacks into next: twice the current one, or 0 once it is at its cap*/
+    std::size_t next_block_size() const noexcept { return this->grow_size == no_growth ? 0 : this->block_size() * 2; }
+
+    /*Element slots in the map, allocated or not*/
+    std::size_t capacity() const noexcept { return this->external_capacity; }
+
+    /*Position of the front element*/
+    std::size_t front_position() const noexcept {
+        return this->first_storage * this->block_size() + this->current_first + 1;
+    }
+
+    /*Position of the raw slot push_back constructs next*/
+    std::size_t back_position() const noexcept {
+        return this->last_storage * this->block_size() + this->current_last;
+    }
+
+    void* block(std::size_t storage) const noexcept { return this->external_storage[storage]; }
+
+    /*Raw slots left in the last block after the back, and in the first block before the front*/
+    std::size_t back_room() const noexcept { return this->block_size() - this->current_last; }
+    std::size_t front_room() const noexcept { return this->current_first + 1; }
+
+    DequeMemoryUsage memory_usage() const noexcept {
+        DequeMemoryUsage usage;
+        usage.map_bytes = this->external_storage.capacity() * sizeof(void*);
+
+        for (std::size_t i = 0; i < this->external_storage.size(); i++) {
+            if (this->external_storage[i] == nullptr) {
+                continue;
+            }
+            if (i >= this->first_storage && i <= this->last_storage) {
+                usage.live_block_bytes += this->block_bytes();
+            } else {
+                usage.idle_block_bytes += this->block_bytes();
+            }
+        }
+
+        return usage;
+    }
+
+#ifdef DEQUE_CHECKED
+    std::size_t generation() const noexcept { return this->generation_count; }
+#endif
+
+    /*=======================================================================^SEGMENTS^=====================================================================*/
+
+    std::size_t segment_count() const noexcept {
+        if (this->external_storage_size == 0) {
+            return 0;
+        }
+        std::size_t first = this->front_position();
+        return (first + this->external_storage_size - 1) / this->block_size() - first / this->block_size() + 1;
+    }
+
+    std::size_t segment_offset(std::size_t k) const noexcept {
+        std::size_t first = this->front_position();
+        return k == 0 ? 0 : (first / this->block_size() + k) * this->block_size() - first;
+    }
+
+    std::size_t segment_of(std::size_t index) const noexcept {
+        std::size_t first = this->front_position();
+        return (first + index) / this->block_size() - first / this->block_size();
+    }
+
+    /*Prefetches the head of block `storage + DEQUE_PREFETCH_DISTANCE` and its successor's map entry; stops at the last live block*/
+    void prefetch_block([[maybe_unused]] std::size_t storage) const noexcept {
+#if DEQUE_PREFETCH_DISTANCE > 0
+        std::size_t ahead = storage + DEQUE_PREFETCH_DISTANCE;
+        if (ahead > this->last_storage) {
+            return;
+        }
+
+        const char* block = static_cast<const char*>(this->external_storage[ahead]);
+        std::size_t bytes = std::min<std::size_t>(DEQUE_PREFETCH_LINES * 64, this->block_bytes());
+        for (std::size_t line = 0; line < bytes; line += 64) {
+            __builtin_prefetch(block + line, 0, 3);
+        }
+        if (ahead < this->last_storage) {
+            __builtin_prefetch(this->external_storage.data() + ahead + 1, 0, 3);
+        }
+#endif
+    }
+
+    /*========================================================================^INDICES^=======================================================================*/
+
+    /* Index bookkeeping of push and pop: the wrapper constructs in the slot first and then takes it in, or gives a slot back and
+     * then destroys it. advance_* allocate the block they move into before changing any index, so when the allocation throws
+     * the core is as it was and the wrapper only has to destroy what it constructed. */
+
+    /*Takes the slot at back_position() into the deque. Like advance_back_by, true when an adaptive core wants larger blocks*/
+    bool advance_back() { return this->advance_back_by(1); }
+
+    /*Takes `count` <= back_room() slots at the back. Returns true when this opened a block and an adaptive core has outgrown
+     * its block size (checked only on block changes, so the common push pays nothing)*/
+    bool advance_back_by(std::size_t count) {
+        if (this->current_last + count == this->block_size()) {
+            this->next_back_block();
+            this->invalidate_iterators();
+            this->external_storage_size += count;
+            return this->external_storage_size >= this->grow_size;
+        }
+        this->invalidate_iterators();
+        this->external_storage_size += count;
+        this->current_last += count;
+        return false;
+    }
+
+    /*Takes the slot before the front into the deque*/
+    bool advance_front() { return this->advance_front_by(1); }
+
+    /*Takes `count` <= front_room() slots before the front; returns like advance_back_by*/
+    bool advance_front_by(std::size_t count) {
+        if (count == this->current_first + 1) {
+            this->next_front_block();
+            this->invalidate_iterators();
+            this->external_storage_size += count;
+            return this->external_storage_size >= this->grow_size;
+        }
+        this->invalidate_iterators();
+        this->external_storage_size += count;
+        this->current_first -= count;
+        return false;
+    }
+
+    /*Gives the last slot back*/
+    void retreat_back() noexcept {
+        this->invalidate_iterators();
+        if (this->current_last == 0) {
+            this->current_last = this->block_size() - 1;
+            this->last_storage--;
+        } else {
+            this->current_last--;
+        }
+        this->external_storage_size--;
+    }
+
+    /*Gives the last `count` slots back*/
+    void retreat_back_by(std::size_t count) noexcept {
+        std::size_t position = this->back_position() - count;
+        this->last_storage = position / this->block_size();
+        this->current_last = position % this->block_size();
+        this->external_storage_size -= count;
+        this->invalidate_iterators();
+    }
+
+    /*Moves the front and back of an empty core to in-block offset `offset` (0 < offset < block_size()) of their block, so up
+     * to block_size() - offset - 1 elements pushed at the back share it*/
+    void start_at(std::size_t offset) noexcept {
+        this->current_first = offset - 1;
+        this->current_last = offset;
+        this->invalidate_iterators();
+    }
+
+    /*Advances the front past count elements*/
+    void drop_front(std::size_t count) noexcept {
+        std::size_t position = this->current_first + count;
+        this->first_storage += position / this->block_size();
+        this->current_first = position % this->block_size();
+        this->external_storage_size -= count;
+        this->invalidate_iterators();
+    }
+
+    /*=======================================================================^BLOCK_MOVES^====================================================================*/
+
+    /* Relinking whole blocks between maps. The callers line the elements up first (partial edge blocks are the typed wrapper's
+     * job), so these only swap pointers: a block that leaves a live range is replaced by an allocated empty one, because the
+     * blocks under first_storage and last_storage must exist even when they hold no element. */
+
+    /*Appends other's blocks by pointer. Requires this back and other's front on block boundaries and other non-empty; other
+     * is left empty*/
+    void splice_back(DequeCore& other) {
+        std::size_t first = other.front_position() / this->block_size();
+        std::size_t count = other.last_storage - first + 1;
+        if (this->last_storage + count >= this->external_storage.size()) {
+            this->resize(count);
+        }
+
+        for (std::size_t i = 0; i < count; i++) {                    // Our empty back block goes to other's first slot.
+            std::swap(this->external_storage[this->last_storage + i], other.external_storage[first + i]);
+        }
+        this->last_storage += count - 1;
+        this->current_last = other.current_last;
+        this->external_storage_size += other.external_storage_size;
+        this->invalidate_iterators();
+        other.reset(first);
+    }
+
+    /*Prepends other's blocks by pointer. Requires this front and other's back on block boundaries and other non-empty; other
+     * is left empty*/
+    void splice_front(DequeCore& other) {
+        std::size_t last = other.last_storage - 1;                   // other's back sits at the start of last_storage.
+        std::size_t count = last - other.first_storage + 1;
+        if (this->first_storage + 1 < count) {
+            this->resize(count);
+        }
+
+        std::size_t target = this->first_storage + 1 - count;        // Our empty front block goes to other's last slot.
+        for (std::size_t i = 0; i < count; i++) {
+            std::swap(this->external_storage[target + i], other.external_storage[other.first_storage + i]);
+        }
+        this->first_storage = target;
+        this->current_first = other.current_first;
+        this->external_storage_size += other.external_storage_size;
+        this->invalidate_iterators();
+        other.reset(last);
+    }
+
+    /* Hands the elements from `position` (strictly inside the deque) to the back over to the new, empty core `tail`: tail takes
+     * the blocks from position's block on by pointer, every element keeping its in-block offset, and this side gets an empty
+     * block in place of position's block. The elements of this side stored in that block before `position` are left behind in
+     * tail.block(tail.front_position() / block_size()); the caller relocates them to the same offsets here. */
+    void split_back(DequeCore& tail, std::size_t position) {
+        std::size_t split = position / this->block_size();
+        std::size_t offset = position % this->block_size();
+        std::size_t count = this->last_storage - split + 1;
+        tail.resize(count + 1);
+
+        void* replacement = nullptr;                                 // An idle block past the back, if there is one.
+        if (this->last_storage + 1 < this->external_storage.size()) {
+            std::swap(replacement, this->external_storage[this->last_storage + 1]);
+        }
+        if (replacement == nullptr) {
+            replacement = this->make_storage();
+        }
+
+        std::size_t start = tail.first_storage + 1;                  // Tail's own empty block stays in front of its first one.
+        for (std::size_t i = 0; i < count; i++) {
+            std::swap(this->external_storage[split + i], tail.external_storage[start + i]);
+        }
+        this->external_storage[split] = replacement;
+
+        tail.first_storage = offset == 0 ? start - 1 : start;
+        tail.current_first = (offset == 0 ? this->block_size() : offset) - 1;
+        tail.last_storage = start + count - 1;
+        tail.current_last = this->current_last;
+        tail.external_storage_size = this->back_position() - position;
+        tail.invalidate_iterators();
+
+        this->last_storage = split;
+        this->current_last = offset;
+        this->external_storage_size -= tail.external_storage_size;
+        this->invalidate_iterators();
+    }
+
+    /*Moves the first `count` full blocks behind the last one. Requires the front and the back on block boundaries*/
+    void move_front_blocks_to_back(std::size_t count) {
+        for (std::size_t i = 0; i < count; i++) {
+            if (this->last_storage + 1 >= this->external_storage.size()) {
+                this->resize();
+            }
+            std::size_t first = this->first_storage + 1;
+            std::size_t last = this->last_storage;
+            void* idle = this->external_storage[last + 1];
+            this->external_storage[last + 1] = this->external_storage[last];         // Empty back block, one step on.
+            this->external_storage[last] = this->external_storage[first];            // Full front block, now the last one.
+            this->external_storage[first] = this->external_storage[first - 1];       // Empty block under the new first_storage.
+            this->external_storage[first - 1] = idle;
+            this->first_storage++;
+            this->last_storage++;
+        }
+        this->invalidate_iterators();
+    }
+
+    /*Releases the idle blocks; the map itself keeps its size*/
+    void shrink_to_fit() noexcept {
+        for (std::size_t i = 0; i < this->external_storage.size(); i++) {
+            if (i < this->first_storage || i > this->last_storage) {
+                this->free_storage(this->external_storage[i]);
+                this->external_storage[i] = nullptr;
+            }
+        }
+    }
+
+private:
+    typedef std::vector<void*, MapAllocator<void*>> map_type;
+
+    const static std::size_t no_growth = ~std::size_t(0);
+
+    std::size_t element_size;
+    BoundBlockAllocator allocator;
+    DequeBlockSizing sizing;
+    std::size_t block_shift;                                         // Elements per block = 1 << block_shift.
+    std::size_t grow_size = no_growth;                               // Size at which an adaptive core asks for larger blocks.
+    std::size_t current_first = 0;
+    std::size_t current_last = 0;
+    std::size_t first_storage = 0;
+    std::size_t last_storage = 0;
+    std::size_t external_storage_size = 0;
+    std::size_t external_capacity = 0;
+    map_type external_storage;
+#ifdef DEQUE_CHECKED
+    std::size_t generation_count = 0;                                // Bumped by every change that moves element indices.
+#endif
+
+    /*Iterators are index-based, so anything that shifts indices or the map invalidates them, like for std::deque*/
+    void invalidate_iterators() noexcept {
+#ifdef DEQUE_CHECKED
+        this->generation_count++;
+#endif
+    }
+
+    /*Empty deque on the allocated block `storage`, with the indices a new core starts with*/
+    void reset(std::size_t storage) noexcept {
+        this->first_storage = storage;
+        this->last_storage = storage;
+        this->current_first = (this->block_size() - 1) / 2 - 1;
+        this->current_last = (this->block_size() - 1) / 2;
+        this->external_storage_size = 0;
+        this->invalidate_iterators();
+    }
+
+    static std::size_t log2_of(std::size_t power) noexcept { return static_cast<std::size_t>(__builtin_ctzll(power)); }
+
+    std::size_t next_grow_size() const noexcept {
+        if (this->sizing == DequeBlockSizing::fixed || this->block_size() * 2 * this->element_size > DEQUE_ADAPTIVE_MAX_BLOCK_BYTES) {
+            return no_growth;
+        }
+        return std::size_t(DEQUE_ADAPTIVE_GROWTH_BLOCKS) << this->block_shift;
+    }
+
+    std::size_t block_bytes() const noexcept { return this->block_size() * this->element_size; }
+
+    /* Вообще оператор new может не вызывать конструктор по умолчанию и выдать просто кусок сырой памяти, что вызовет ub.
+     * Blocks are raw bytes from the allocation policy, the elements are constructed in place by the wrapper */
+    void* make_storage() { return this->allocator.allocate(this->block_bytes()); }
+
+    /*Out of line, so the check in allocate_if_needed is all a push inlines*/
+    __attribute__((noinline)) void allocate_map() {
+        this->external_storage.assign(EXTERNAL_INIT_SIZE, nullptr);
+        this->external_storage[0] = this->make_storage();
+        this->reset(0);
+        this->external_capacity = this->block_size() * EXTERNAL_INIT_SIZE;
+        this->grow_size = this->next_grow_size();
+    }
+
+    void free_storage(void* storage) noexcept {
+        if (storage != nullptr) {
+            this->allocator.deallocate(storage, this->block_bytes());
+        }
+    }
+
+    void ensure_storage(std::size_t storage) {
+        if (this->external_storage[storage] == nullptr) {
+            this->external_storage[storage] = this->make_storage();
+        }
+    }
+
+    /*The back crossed into the next block (same block change for push_back and append). The map and the block come first: if
+     * either allocation throws, the indices are unchanged (a resize only recenters them)*/
+    void next_back_block() {
+        if (this->last_storage + 1 >= this->external_storage.size()) {
+            this->resize();
+        }
+        this->ensure_storage(this->last_storage + 1);
+        this->last_storage++;
+        this->current_last = 0;
+    }
+
+    /*The front crossed into the previous block (same block change for push_front and prepend), allocating first like
+     * next_back_block*/
+    void next_front_block() {
+        if (this->first_storage == 0) {
+            this->resize();
+        }
+        this->ensure_storage(this->first_storage - 1);
+        this->first_storage--;
+        this->current_first = this->block_size() - 1;
+    }
+
+    /* Дисклеймер (ЗДЕСЬ МОГ БЫТЬ ВАШ ЛИСТ), однако определенным образом подбирая initial_size - константа степени 2(символично),
+     * мы можем практически избежать вызова метода resize, поддерживать операции за все те же O(1). Метод крайне простоват:
+     * создаем новый внешний сторедж(вектор) размер X2, затем присваиваем внутренним стореджам внутренние стореджи старого вектора.
+     * При этом по сути поэлементного копирования не происходит. (Вся сложность поддерживать индексы как на примере в самом верху)
+     *
+     * The map only doubles when the live blocks take more than half of it; otherwise they are just recentered, which keeps a FIFO
+     * (push_back + pop_front) from growing the map forever. Blocks are allocated lazily by push_*, and idle blocks left behind by
+     * pop_* are moved to the free slots at both ends instead of being freed, so a steady-state queue stops calling new.
+     * Afterwards there are at least `extra` free map slots at each end. */
+    void resize(std::size_t extra = 1) {
+        std::size_t live = this->last_storage - this->first_storage + 1;
+        std::size_t new_size = this->external_storage.size();
+        if ((live + 1) * 2 > new_size) {
+            new_size *= 2;
+        }
+        while ((new_size - live) / 2 < extra) {
+            new_size *= 2;
+        }
+
+        map_type new_external_storage(new_size, nullptr, this->external_storage.get_allocator());
+        std::size_t new_first = (new_size - live) / 2;
+
+        for (std::size_t i = 0; i < live; i++) {
+            new_external_storage[new_first + i] = this->external_storage[this->first_storage + i];
+        }
+
+        std::size_t front_slot = new_first;
+        std::size_t back_slot = new_first + live;
+        bool to_back = true;
+
+        for (std::size_t i = 0; i < this->external_storage.size(); i++) {
+            void* storage = this->external_storage[i];
+            if (storage == nullptr || (i >= this->first_storage && i <= this->last_storage)) {
+                continue;
+            }
+
+            if (to_back && back_slot < new_size) {
+                new_external_storage[back_slot++] = storage;
+            } else if (front_slot > 0) {
+                new_external_storage[--front_slot] = storage;
+            } else if (back_slot < new_size) {
+                new_external_storage[back_slot++] = storage;
+            } else {
+                this->free_storage(storage);
+            }
+            to_back = !to_back;
+        }
+
+        this->first_storage = new_first;
+        this->last_storage = new_first + live - 1;
+        this->external_storage.swap(new_external_storage);
+        this->external_capacity = this->external_storage.size() * this->block_size();
+        this->invalidate_iterators();
+    }
+};
+
+#endif  // SRC_DEQUE_CORE_HPP_
@@ -0,0 +1,12 @@
+/* Explicit instantiations behind DequeExtern.hpp. Always built unchecked, whatever the rest of the build uses: that is the layout
+ * the extern declarations promise. */
+
+#undef DEQUE_CHECKED
+
+#include "DequeExtern.hpp"
+
+#define DEQUE_INSTANTIATE(Type)                     \
+    template class Deque<Type, CachedBlockAllocator>; \
+    template class Deque<Type, HeapBlockAllocator>;
+DEQUE_EXTERN_INSTANCES(DEQUE_INSTANTIATE)
+#undef DEQUE_INSTANTIATE
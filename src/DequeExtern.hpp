@@ -0,0 +1,30 @@
+#ifndef SRC_DEQUE_EXTERN_HPP_
+#define SRC_DEQUE_EXTERN_HPP_
+
+#include <cstdint>
+
+#include "Deque.hpp"
+
+/*Deque for the common element types is explicitly instantiated once, in the own_deque::instances library (DequeExtern.cpp).
+ * Include this header instead of Deque.hpp and link that library: the translation units then stop emitting their own copies of
+ * those members. Both block policies are provided, so DEQUE_NO_BLOCK_CACHE may differ between the library and its users; checked
+ * builds change the class layout and keep instantiating locally.*/
+#define DEQUE_EXTERN_INSTANCES(X) \
+    X(int)                        \
+    X(unsigned)                   \
+    X(std::int64_t)               \
+    X(std::uint64_t)              \
+    X(double)                     \
+    X(void*)                      \
+    X(const void*)                \
+    X(const char*)
+
+#ifndef DEQUE_CHECKED
+#define DEQUE_EXTERN_TEMPLATE(Type)                                \
+    extern template class Deque<Type, CachedBlockAllocator>; \
+    extern template class Deque<Type, HeapBlockAllocator>;
+DEQUE_EXTERN_INSTANCES(DEQUE_EXTERN_TEMPLATE)
+#undef DEQUE_EXTERN_TEMPLATE
+#endif
+
+#endif  // SRC_DEQUE_EXTERN_HPP_
@@ -0,0 +1,36 @@
+#ifndef SRC_DEQUE_IO_HPP_
+#define SRC_DEQUE_IO_HPP_
+
+#include <iostream>
+
+#include "Deque.hpp"
+
+/*Stream output for Deque. It lives apart from Deque.hpp so that only the translation units that print pay for <iostream>*/
+
+/*Prints the elements block by block, one line per block*/
+template <typename T, typename BlockAllocator>
+void print_deque(Deque<T, BlockAllocator>& deque, std::ostream& out = std::cout) {
+    deque.for_each_segment([&out](DequeSegment<T*> segment) {
+        for (const auto& value : segment) {
+            out << value << " ";
+        }
+        out << std::endl;
+    });
+    out << "\n\n\n\n";
+}
+
+template <typename T, typename BlockAllocator>
+std::ostream& operator<<(std::ostream& out, Deque<T, BlockAllocator>* source) noexcept {
+    if (source == nullptr) {
+        return out;
+    }
+
+    for (auto it = source->begin(); it != source->end(); ++it) {
+        out << *it << " ";
+    }
+    out << std::endl;
+
+    return out;
+}
+
+#endif  // SRC_DEQUE_IO_HPP_
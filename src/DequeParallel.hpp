@@ -0,0 +1,51 @@
+#ifndef SRC_DEQUE_PARALLEL_HPP_
+#define SRC_DEQUE_PARALLEL_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "Deque.hpp"
+
+/*Copying a Deque out on several threads. It lives apart from Deque.hpp so that only the translation units that use it pay for
+ * <thread>*/
+
+/*Minimum bytes per thread before parallel_copy_to splits a copy between threads*/
+#ifndef DEQUE_PARALLEL_COPY_BYTES
+#define DEQUE_PARALLEL_COPY_BYTES (std::size_t(4) << 20)
+#endif
+
+/*Deque::copy_to, with trivially copyable deques bigger than DEQUE_PARALLEL_COPY_BYTES split by blocks between up to `threads`
+ * threads (each gets at least that many bytes). Anything smaller is copied on the calling thread*/
+template <typename T, typename BlockAllocator>
+void parallel_copy_to(const Deque<T, BlockAllocator>& deque, T* destination,
+                      std::size_t threads = std::thread::hardware_concurrency()) {
+    std::size_t segments = deque.segment_count();
+    if constexpr (std::is_trivially_copyable<T>::value) {
+        std::size_t bytes = deque.get_size() * sizeof(T);
+        threads = std::min({threads, segments, bytes / DEQUE_PARALLEL_COPY_BYTES});
+    } else {
+        threads = 1;
+    }
+
+    if (threads <= 1) {
+        deque.copy_to(destination);
+        return;
+    }
+
+    auto work = [&deque, destination, segments, threads](std::size_t t) {
+        deque.copy_segments_to(destination, segments * t / threads, segments * (t + 1) / threads);
+    };
+    std::vector<std::thread> pool;
+    for (std::size_t t = 1; t < threads; t++) {
+        pool.emplace_back(work, t);
+    }
+    work(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+#endif  // SRC_DEQUE_PARALLEL_HPP_
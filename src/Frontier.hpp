@@ -0,0 +1,104 @@
+#ifndef SRC_FRONTIER_HPP_
+#define SRC_FRONTIER_HPP_
+
+#include <cstdint>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "Deque.hpp"
+
+/*BFS frontier on top of Deque. Besides single pushes at both ends (push_front serves the 0-weight edges of 0-1 BFS), it moves
+ * whole adjacency spans in and whole batches out with one block-sized copy per block instead of one call per node.
+ *
+ * expand_level() is the level-synchronous mode: the blocks of the current frontier are split between threads, every thread expands
+ * its nodes into a private buffer, and the buffers are appended in thread order, so the next frontier is the same for any thread
+ * count as long as expand() itself is deterministic. expand() runs concurrently and must synchronise its own shared state (a
+ * visited bitmap claimed with an atomic exchange is the usual choice). An exception from expand() on any thread is rethrown on the
+ * caller once every thread has been joined, and the frontier keeps the current level.*/
+template <typename Node = uint32_t>
+class Frontier {
+private:
+    Deque<Node> queue;
+
+    /*Below this many nodes per thread the spawn cost outweighs the work*/
+    static const std::size_t min_nodes_per_thread = 4096;
+
+public:
+    std::size_t get_size() const noexcept { return this->queue.get_size(); }
+
+    bool empty() const noexcept { return this->queue.empty(); }
+
+    const Deque<Node>& deque() const noexcept { return this->queue; }
+
+    void push(Node node) { this->queue.push_back(node); }
+
+    void push_front(Node node) { this->queue.push_front(node); }
+
+    void push_span(const Node* nodes, std::size_t count) { this->queue.append(nodes, count); }
+
+    void push_span_front(const Node* nodes, std::size_t count) { this->queue.prepend(nodes, count); }
+
+    Node pop() {
+        Node node = this->queue.front();
+        this->queue.pop_front();
+        return node;
+    }
+
+    /*Moves up to max_count nodes into batch; returns how many were taken*/
+    std::size_t pop_batch(Node* batch, std::size_t max_count) { return this->queue.pop_front_into(batch, max_count); }
+
+    void clear() noexcept { this->queue.clear(); }
+
+    /*Replaces the frontier by the next level: expand(node, std::vector<Node>& next) is called once per node of the current level*/
+    template <typename Expand>
+    void expand_level(std::size_t threads, Expand expand) {
+        std::size_t segments = this->queue.segment_count();
+        threads = std::max<std::size_t>(1, std::min({threads, segments, this->queue.get_size() / min_nodes_per_thread}));
+        std::vector<std::vector<Node>> next(threads);
+        std::vector<std::exception_ptr> errors(threads);
+
+        auto work = [this, &expand, &next, &errors, segments, threads](std::size_t t) {
+            try {
+                for (std::size_t k = segments * t / threads; k < segments * (t + 1) / threads; k++) {
+                    for (Node node : this->queue.segment(k)) {
+                        expand(node, next[t]);
+                    }
+                }
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        };
+
+        if (threads == 1) {
+            work(0);
+        } else {
+            std::vector<std::thread> pool;
+            pool.reserve(threads - 1);
+            struct JoinAll {                                         // Also joins the threads started before a failed spawn.
+                std::vector<std::thread>& pool;
+                ~JoinAll() {
+                    for (auto& thread : this->pool) {
+                        thread.join();
+                    }
+                }
+            } join_all{pool};
+            for (std::size_t t = 1; t < threads; t++) {
+                pool.emplace_back(work, t);
+            }
+            work(0);
+        }
+        for (auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        this->queue.clear();
+        for (auto& nodes : next) {
+            this->queue.append(nodes.data(), nodes.size());
+        }
+    }
+};
+
+#endif  // SRC_FRONTIER_HPP_
@@ -0,0 +1,170 @@
+#ifndef SRC_INDEXED_DEQUE_HPP_
+#define SRC_INDEXED_DEQUE_HPP_
+
+#include <type_traits>
+
+#include "Deque.hpp"
+
+/*Deque augmented with per-block running sums for arbitrary range-sum queries.
+ *
+ * The side structure `bounds` has one entry per block boundary, aligned with the segments of `values` (and so with the blocks of
+ * its external_storage): the sum of segment k is bounds[k + 1] - bounds[k]. Every push/pop adjusts only the boundary at the end it
+ * touches, and a block appearing or draining adds or drops one boundary, so updates are O(1). range_sum(i, j) is then
+ *
+ *   (partial first block) + (bounds[last] - bounds[first + 1]) + (partial last block)
+ *
+ * with the two partial blocks summed directly over contiguous memory.
+ *
+ * Sum is the accumulator type (e.g. int64_t for int values). The boundaries are running sums that a rolling queue pushes in one
+ * direction forever, so for integer Sum they are stored in its unsigned counterpart: they wrap instead of overflowing, and the
+ * difference of two boundaries is still exact whenever the sum between them fits in Sum. With floating-point sums the boundaries
+ * keep absorbing additions and subtractions, so long-running queues should call rebuild() now and then to drop the accumulated
+ * rounding error.*/
+template <typename T, typename Sum = T>
+class IndexedDeque {
+private:
+    typedef typename std::conditional_t<std::is_integral<Sum>::value, std::make_unsigned<Sum>, std::common_type<Sum>>::type Bound;
+
+    Deque<T> values;
+    Deque<Bound> bounds;
+
+    static Bound bound_of(const T& value) noexcept { return static_cast<Bound>(static_cast<Sum>(value)); }
+
+    /*Several independent accumulators break the add dependency chain, which lets the compiler keep them in vector registers*/
+    static Sum contiguous_sum(const T* data, std::size_t count) noexcept {
+        Sum lanes[8] = {};
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            for (std::size_t lane = 0; lane < 8; lane++) {
+                lanes[lane] += static_cast<Sum>(data[i + lane]);
+            }
+        }
+        Sum sum = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+        for (; i < count; i++) {
+            sum += static_cast<Sum>(data[i]);
+        }
+        return sum;
+    }
+
+    /*Sum of elements [from, to) of segment k, in segment-local positions*/
+    Sum segment_sum(std::size_t k, std::size_t from, std::size_t to) const noexcept {
+        return contiguous_sum(this->values.segment(k).data + from, to - from);
+    }
+
+public:
+    /*========================================================================^LOOKUP^========================================================================*/
+
+    std::size_t get_size() const noexcept { return this->values.get_size(); }
+
+    bool empty() const noexcept { return this->values.empty(); }
+
+    const T& operator[](std::size_t index) const { return this->values[index]; }
+
+    const Deque<T>& deque() const noexcept { return this->values; }
+
+    /*Sum of elements [first, last)*/
+    Sum range_sum(std::size_t first, std::size_t last) const noexcept {
+        if (first >= last) {
+            return Sum();
+        }
+
+        std::size_t first_segment = this->values.segment_of(first);
+        std::size_t last_segment = this->values.segment_of(last - 1);
+        std::size_t first_local = first - this->values.segment_offset(first_segment);
+        std::size_t last_local = last - this->values.segment_offset(last_segment);
+
+        if (first_segment == last_segment) {
+            return this->segment_sum(first_segment, first_local, last_local);
+        }
+
+        Sum head = this->segment_sum(first_segment, first_local, this->values.segment(first_segment).size);
+        Sum middle = static_cast<Sum>(this->bounds[last_segment] - this->bounds[first_segment + 1]);
+        Sum tail = this->segment_sum(last_segment, 0, last_local);
+        return head + middle + tail;
+    }
+
+    Sum total() const noexcept { return this->range_sum(0, this->get_size()); }
+
+    /*========================================================================^METHODS^=======================================================================*/
+
+    void push_back(const T& value) {
+        std::size_t segments = this->values.segment_count();
+        this->values.push_back(value);
+
+        if (segments == 0) {
+            this->bounds.push_back(Bound());
+        }
+        if (this->values.segment_count() > segments) {
+            this->bounds.push_back(this->bounds.back() + bound_of(value));
+        } else {
+            this->bounds.back() += bound_of(value);
+        }
+    }
+
+    void push_front(const T& value) {
+        std::size_t segments = this->values.segment_count();
+        this->values.push_front(value);
+
+        if (segments == 0) {
+            this->bounds.push_front(Bound());
+        }
+        if (this->values.segment_count() > segments) {
+            this->bounds.push_front(this->bounds.front() - bound_of(value));
+        } else {
+            this->bounds.front() -= bound_of(value);
+        }
+    }
+
+    void pop_front() {
+        if (this->empty()) {
+            return;
+        }
+        std::size_t segments = this->values.segment_count();
+        Bound value = bound_of(this->values.front());
+        this->values.pop_front();
+
+        if (this->values.segment_count() < segments) {
+            this->bounds.pop_front();
+        } else {
+            this->bounds.front() += value;
+        }
+        if (this->values.empty()) {
+            this->bounds.pop_front();
+        }
+    }
+
+    void pop_back() {
+        if (this->empty()) {
+            return;
+        }
+        std::size_t segments = this->values.segment_count();
+        Bound value = bound_of(this->values.back());
+        this->values.pop_back();
+
+        if (this->values.segment_count() < segments) {
+            this->bounds.pop_back();
+        } else {
+            this->bounds.back() -= value;
+        }
+        if (this->values.empty()) {
+            this->bounds.pop_back();
+        }
+    }
+
+    /*Recomputes the boundaries from the values, O(n)*/
+    void rebuild() {
+        Deque<Bound> fresh;
+        Bound running = Bound();
+        for (std::size_t k = 0; k < this->values.segment_count(); k++) {
+            fresh.push_back(running);
+            auto segment = this->values.segment(k);
+            running += static_cast<Bound>(contiguous_sum(segment.data, segment.size));
+        }
+        if (!this->values.empty()) {
+            fresh.push_back(running);
+        }
+        this->bounds = std::move(fresh);
+    }
+};
+
+#endif  // SRC_INDEXED_DEQUE_HPP_
@@ -0,0 +1,403 @@
+#ifndef SRC_ROPE_DEQUE_HPP_
+#define SRC_ROPE_DEQUE_HPP_
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "Deque.hpp"
+
+/*Deque variant for workloads that edit the middle. Unlike Deque, whose inner blocks are always full, every block here carries its
+ * own [begin, end) window and may be partially filled, so inserting or erasing in the middle only shifts the shorter side of ONE
+ * block. A Fenwick tree over the block sizes turns an element index into (block, offset) in O(log blocks).
+ *
+ *   operator[]            O(log blocks)
+ *   push_* / pop_*        O(log blocks) amortized: a Fenwick point update, and O(1) amortized block changes at either end
+ *   insert / erase        O(block) + O(blocks) when a block has to be split or merged
+ *
+ * Like the map of Deque, the block vector keeps empty slots before the first block. A slot holds no elements, so its Fenwick
+ * entry is already 0 and push_front/pop_front open or free a front block without touching the index; only running out of
+ * slots regrows the vector (doubling the slack) and rebuilds the index, which is O(1) amortized per block.
+ *
+ * A full block is split in two on insert; a block that drops under a quarter full is merged into a neighbour when the pair fits
+ * in half a block, which keeps the block count within a constant factor of size / block_capacity.*/
+template <typename T, std::size_t BlockBytes = 4096>
+class RopeDeque {
+public:
+    static constexpr std::size_t block_capacity = BlockBytes / sizeof(T) < 16 ? 16 : BlockBytes / sizeof(T);
+
+private:
+    struct Block {
+        T* data;
+        std::size_t begin;
+        std::size_t end;
+
+        std::size_t size() const noexcept { return this->end - this->begin; }
+    };
+
+    std::vector<Block> blocks;                                       // Slots [0, first_block) are empty slack for push_front.
+    std::vector<std::size_t> fenwick;                                // 1-based, fenwick[i] covers blocks (i - lowbit(i), i].
+    std::size_t first_block = 0;
+    std::size_t total_size = 0;
+
+    /*=================================================================^BLOCK_MANAGEMENT^=================================================================*/
+
+    static Block make_block(std::size_t position) {
+        return {std::allocator<T>().allocate(block_capacity), position, position};
+    }
+
+    static void free_block(Block& block) noexcept {
+        std::destroy(block.data + block.begin, block.data + block.end);
+        std::allocator<T>().deallocate(block.data, block_capacity);
+    }
+
+    /*Moves the elements so that the free space is split evenly between both sides*/
+    static void recenter(Block& block) {
+        std::size_t size = block.size();
+        std::size_t begin = (block_capacity - size) / 2;
+        if (begin == block.begin) {
+            return;
+        }
+
+        T* scratch = std::allocator<T>().allocate(size);
+        std::uninitialized_move(block.data + block.begin, block.data + block.end, scratch);
+        std::destroy(block.data + block.begin, block.data + block.end);
+        std::uninitialized_move(scratch, scratch + size, block.data + begin);
+        std::destroy(scratch, scratch + size);
+        std::allocator<T>().deallocate(scratch, size);
+
+        block.begin = begin;
+        block.end = begin + size;
+    }
+
+    /*Inserts at `offset` inside a block that has room on at least one side, shifting the shorter side*/
+    static void insert_into(Block& block, std::size_t offset, T&& value) {
+        std::size_t size = block.size();
+        bool shift_right = block.end < block_capacity && (offset >= size / 2 || block.begin == 0);
+
+        if (shift_right) {
+            T* slot = block.data + block.begin + offset;
+            if (offset == size) {
+                ::new (static_cast<void*>(slot)) T(std::move(value));
+            } else {
+                ::new (static_cast<void*>(block.data + block.end)) T(std::move(block.data[block.end - 1]));
+                std::move_backward(slot, block.data + block.end - 1, block.data + block.end);
+                *slot = std::move(value);
+            }
+            block.end++;
+        } else {
+            T* first = block.data + block.begin;
+            if (offset == 0) {
+                ::new (static_cast<void*>(first - 1)) T(std::move(value));
+            } else {
+                ::new (static_cast<void*>(first - 1)) T(std::move(*first));
+                std::move(first + 1, first + offset, first);
+                first[offset - 1] = std::move(value);
+            }
+            block.begin--;
+        }
+    }
+
+    static void erase_from(Block& block, std::size_t offset) {
+        T* first = block.data + block.begin;
+        if (offset < block.size() / 2) {
+            std::move_backward(first, first + offset, first + offset + 1);
+            std::destroy_at(first);
+            block.begin++;
+        } else {
+            std::move(first + offset + 1, block.data + block.end, first + offset);
+            std::destroy_at(block.data + block.end - 1);
+            block.end--;
+        }
+    }
+
+    /*Splits a full block in half; returns the index of the block holding element `offset` of the old block afterwards*/
+    std::size_t split(std::size_t index, std::size_t& offset) {
+        Block& block = this->blocks[index];
+        std::size_t keep = block.size() / 2;
+        std::size_t moved = block.size() - keep;
+
+        Block upper = make_block((block_capacity - moved) / 2);
+        std::uninitialized_move(block.data + block.begin + keep, block.data + block.end, upper.data + upper.begin);
+        std::destroy(block.data + block.begin + keep, block.data + block.end);
+        upper.end = upper.begin + moved;
+        block.end = block.begin + keep;
+
+        this->blocks.insert(this->blocks.begin() + index + 1, upper);
+        this->rebuild_index();
+
+        if (offset > keep) {                                         // offset == keep appends to the lower half.
+            offset -= keep;
+            return index + 1;
+        }
+        return index;
+    }
+
+    /*Merges an underfull block into a neighbour when the pair fits in half a block*/
+    void rebalance(std::size_t index) {
+        Block& block = this->blocks[index];
+        if (block.size() == 0) {
+            free_block(block);
+            this->blocks.erase(this->blocks.begin() + index);
+            this->rebuild_index();
+            return;
+        }
+        if (block.size() >= block_capacity / 4) {
+            return;
+        }
+
+        std::size_t left = index;
+        if (index + 1 < this->blocks.size() && this->blocks[index + 1].size() + block.size() <= block_capacity / 2) {
+            left = index;
+        } else if (index > this->first_block && this->blocks[index - 1].size() + block.size() <= block_capacity / 2) {
+            left = index - 1;
+        } else {
+            return;
+        }
+
+        Block& into = this->blocks[left];
+        Block& from = this->blocks[left + 1];
+        if (into.end + from.size() > block_capacity) {
+            recenter(into);                                          // The pair fits in half a block, so this always makes room.
+        }
+
+        std::uninitialized_move(from.data + from.begin, from.data + from.end, into.data + into.end);
+        into.end += from.size();
+        free_block(from);
+        this->blocks.erase(this->blocks.begin() + left + 1);
+        this->rebuild_index();
+    }
+
+    /*======================================================================^FENWICK^=====================================================================*/
+
+    void rebuild_index() {
+        std::size_t count = this->blocks.size();
+        this->fenwick.assign(count + 1, 0);
+        for (std::size_t i = 1; i <= count; i++) {
+            this->fenwick[i] += this->blocks[i - 1].size();
+            std::size_t parent = i + (i & (~i + 1));
+            if (parent <= count) {
+                this->fenwick[parent] += this->fenwick[i];
+            }
+        }
+    }
+
+    /*Sum of the sizes of the first `count` blocks*/
+    std::size_t prefix(std::size_t count) const noexcept {
+        std::size_t sum = 0;
+        for (std::size_t i = count; i > 0; i -= i & (~i + 1)) {
+            sum += this->fenwick[i];
+        }
+        return sum;
+    }
+
+    void add_to_index(std::size_t block, std::ptrdiff_t delta) {
+        for (std::size_t i = block + 1; i < this->fenwick.size(); i += i & (~i + 1)) {
+            this->fenwick[i] += static_cast<std::size_t>(delta);
+        }
+    }
+
+    /*Finds the block holding element `index`; `index` becomes the offset inside that block*/
+    std::size_t locate(std::size_t& index) const noexcept {
+        std::size_t position = 0;
+        std::size_t step = 1;
+        while (step * 2 < this->fenwick.size()) {
+            step *= 2;
+        }
+
+        for (; step > 0; step /= 2) {
+            if (position + step < this->fenwick.size() && this->fenwick[position + step] <= index) {
+                position += step;
+                index -= this->fenwick[position];
+            }
+        }
+        return position;
+    }
+
+public:
+    /*=============================================================^CONSTRUCTORS_AND_DESTRUCTORS^=============================================================*/
+
+    RopeDeque() = default;
+
+    RopeDeque(const RopeDeque& other) : RopeDeque() {
+        for (std::size_t k = 0; k < other.segment_count(); k++) {
+            for (const T& value : other.segment(k)) {
+                this->push_back(value);
+            }
+        }
+    }
+
+    RopeDeque(RopeDeque&& other) noexcept : RopeDeque() { this->swap(other); }
+
+    RopeDeque& operator=(RopeDeque other) noexcept {
+        this->swap(other);
+        return *this;
+    }
+
+    ~RopeDeque() { this->clear(); }
+
+    void swap(RopeDeque& other) noexcept {
+        this->blocks.swap(other.blocks);
+        this->fenwick.swap(other.fenwick);
+        std::swap(this->first_block, other.first_block);
+        std::swap(this->total_size, other.total_size);
+    }
+
+    void clear() noexcept {
+        for (std::size_t k = this->first_block; k < this->blocks.size(); k++) {
+            free_block(this->blocks[k]);
+        }
+        this->blocks.clear();
+        this->fenwick.clear();
+        this->first_block = 0;
+        this->total_size = 0;
+    }
+
+    /*========================================================================^LOOKUP^========================================================================*/
+
+    std::size_t get_size() const noexcept { return this->total_size; }
+
+    bool empty() const noexcept { return this->total_size == 0; }
+
+    std::size_t block_count() const noexcept { return this->blocks.size() - this->first_block; }
+
+    T& operator[](std::size_t index) {
+        std::size_t block = this->locate(index);
+        return this->blocks[block].data[this->blocks[block].begin + index];
+    }
+
+    const T& operator[](std::size_t index) const {
+        std::size_t block = this->locate(index);
+        return this->blocks[block].data[this->blocks[block].begin + index];
+    }
+
+    T& front() { return this->blocks[this->first_block].data[this->blocks[this->first_block].begin]; }
+
+    T& back() { return this->blocks.back().data[this->blocks.back().end - 1]; }
+
+    /*Blocks are the natural unit for scans: each is one contiguous run*/
+    std::size_t segment_count() const noexcept { return this->block_count(); }
+
+    DequeSegment<T*> segment(std::size_t k) noexcept {
+        const Block& block = this->blocks[this->first_block + k];
+        return {block.data + block.begin, block.size()};
+    }
+
+    DequeSegment<const T*> segment(std::size_t k) const noexcept {
+        const Block& block = this->blocks[this->first_block + k];
+        return {block.data + block.begin, block.size()};
+    }
+
+    /*========================================================================^METHODS^=======================================================================*/
+
+    void push_back(T value) {
+        if (this->empty() || this->blocks.back().end == block_capacity) {
+            if (this->fenwick.empty()) {
+                this->fenwick.push_back(0);
+            }
+            this->blocks.push_back(make_block(0));
+            std::size_t node = this->blocks.size();                  // New empty last node: covers (node - lowbit, node].
+            this->fenwick.push_back(this->prefix(node - 1) - this->prefix(node - (node & (~node + 1))));
+        }
+        Block& block = this->blocks.back();
+        ::new (static_cast<void*>(block.data + block.end)) T(std::move(value));
+        block.end++;
+        this->total_size++;
+        this->add_to_index(this->blocks.size() - 1, 1);
+    }
+
+    void push_front(T value) {
+        if (this->empty() || this->blocks[this->first_block].begin == 0) {
+            if (this->first_block == 0) {
+                std::size_t slack = std::max<std::size_t>(this->blocks.size(), 4);
+                this->blocks.insert(this->blocks.begin(), slack, Block{nullptr, 0, 0});
+                this->first_block = slack;
+                this->rebuild_index();                               // Only when the slack doubles.
+            }
+            this->blocks[this->first_block - 1] = make_block(block_capacity);
+            this->first_block--;                                     // An empty block: its Fenwick entry stays 0.
+        }
+        Block& block = this->blocks[this->first_block];
+        ::new (static_cast<void*>(block.data + block.begin - 1)) T(std::move(value));
+        block.begin--;
+        this->total_size++;
+        this->add_to_index(this->first_block, 1);
+    }
+
+    void pop_back() {
+        if (this->empty()) {
+            return;
+        }
+        Block& block = this->blocks.back();
+        std::destroy_at(block.data + block.end - 1);
+        block.end--;
+        this->total_size--;
+        this->add_to_index(this->blocks.size() - 1, -1);
+        if (this->empty()) {
+            this->clear();
+        } else if (block.size() == 0) {
+            free_block(block);
+            this->blocks.pop_back();
+            this->fenwick.pop_back();
+        }
+    }
+
+    void pop_front() {
+        if (this->empty()) {
+            return;
+        }
+        Block& block = this->blocks[this->first_block];
+        std::destroy_at(block.data + block.begin);
+        block.begin++;
+        this->total_size--;
+        this->add_to_index(this->first_block, -1);
+        if (this->empty()) {
+            this->clear();
+        } else if (block.size() == 0) {
+            free_block(block);
+            block = Block{nullptr, 0, 0};                            // Back to slack; its Fenwick entry is already 0.
+            this->first_block++;
+        }
+    }
+
+    /*Inserts before element `index` (index == size appends)*/
+    void insert(std::size_t index, T value) {
+        if (index == this->total_size) {
+            this->push_back(std::move(value));
+            return;
+        }
+        if (index == 0) {
+            this->push_front(std::move(value));
+            return;
+        }
+
+        std::size_t offset = index;
+        std::size_t block = this->locate(offset);
+        if (offset == 0 && this->blocks[block - 1].end < block_capacity) {   // Append to the previous block instead.
+            block--;
+            offset = this->blocks[block].size();
+        }
+
+        if (this->blocks[block].size() == block_capacity) {           // A block that is not full has room on at least one side.
+            block = this->split(block, offset);
+        }
+
+        insert_into(this->blocks[block], offset, std::move(value));
+        this->total_size++;
+        this->add_to_index(block, 1);
+    }
+
+    void erase(std::size_t index) {
+        std::size_t offset = index;
+        std::size_t block = this->locate(offset);
+
+        erase_from(this->blocks[block], offset);
+        this->total_size--;
+        this->add_to_index(block, -1);
+        this->rebalance(block);
+    }
+};
+
+#endif  // SRC_ROPE_DEQUE_HPP_
@@ -0,0 +1,375 @@
+#ifndef SRC_SHM_DEQUE_HPP_
+#define SRC_SHM_DEQUE_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "DequeCore.hpp"
+
+/*Who may push into a ShmDeque. There is always exactly one consumer*/
+enum class ShmProducers { single, multiple };
+
+/*Thrown by ShmDeque::open() for a segment whose creator has not finished initializing it; opening again later may succeed*/
+class ShmDequeNotReady : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/* Bounded FIFO of trivially copyable T in a POSIX shared-memory segment (shm_open + mmap), for passing work between processes on
+ * one host without a syscall per message. One process create()s the segment by name, the others open() it; unlink() removes the
+ * name, and the memory goes away with the last mapping.
+ *
+ * The segment holds a header, the map and the blocks. Like Deque's map, the map lists the blocks of initial_size elements, but
+ * as byte offsets from the segment start rather than pointers, because every process maps the segment at its own address. The
+ * capacity is fixed at creation (rounded up to whole blocks) and the blocks are used as a ring: element position p sits in
+ * block (p % capacity) / initial_size.
+ *
+ * Both indices are 64-bit counters that only grow, each on its own cache line:
+ *   - ShmProducers::single: classic SPSC ring. The producer owns tail, the consumer owns head, and each side caches the other's
+ *     counter so the shared line is only read when the ring looks full or empty. push_span and pop_batch publish a whole span
+ *     with one release store.
+ *   - ShmProducers::multiple: every cell carries a sequence number (Vyukov's bounded queue). Producers claim positions with a
+ *     CAS on tail and publish the cell through its sequence, the single consumer frees it by advancing the sequence one lap.
+ * try_push and try_pop never block; the caller decides how to wait when they fail.*/
+template <typename T, ShmProducers Producers = ShmProducers::single>
+class ShmDeque {
+    static_assert(std::is_trivially_copyable<T>::value, "ShmDeque copies elements as bytes between processes");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared counters must be address-free");
+
+private:
+    const static std::size_t initial_size = DequeCore::initial_size;
+    const static uint64_t segment_magic = 0x73686d6471756575;        // "shmdqueu"
+
+    struct SingleCell {
+        T value;
+    };
+
+    struct SequencedCell {
+        std::atomic<uint64_t> sequence;
+        T value;
+    };
+
+    typedef typename std::conditional<Producers == ShmProducers::single, SingleCell, SequencedCell>::type Cell;
+
+    /*Blocks start on a cache line, or on the cell's own alignment when that is stricter. The segment itself is page aligned*/
+    static constexpr std::size_t block_alignment = alignof(Cell) > 64 ? alignof(Cell) : 64;
+    static_assert(block_alignment <= 4096, "ShmDeque cells cannot be aligned beyond a page");
+
+    struct Header {
+        std::atomic<uint64_t> magic;                                 // Stored last by create(): the segment is ready.
+        uint64_t cell_size;
+        uint64_t producers;
+        uint64_t capacity;
+        uint64_t block_count;
+        uint64_t segment_bytes;
+        alignas(64) std::atomic<uint64_t> head;
+        alignas(64) std::atomic<uint64_t> tail;
+    };                                                               // The map (block_count offsets) follows.
+
+    char* base = nullptr;
+    std::size_t mapped_bytes = 0;
+    Header* header = nullptr;
+    uint64_t capacity_cells = 0;
+    uint64_t cached_head = 0;                                        // Producer's view of head (single producer only).
+    uint64_t cached_tail = 0;                                        // Consumer's view of tail.
+
+    static std::size_t align_up(std::size_t value, std::size_t alignment) noexcept {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    static std::size_t map_end(std::size_t block_count) noexcept {
+        return align_up(sizeof(Header) + block_count * sizeof(uint64_t), block_alignment);
+    }
+
+    static std::system_error system_error(const std::string& what) {
+        return std::system_error(errno, std::generic_category(), what);
+    }
+
+    ShmDeque(char* _base, std::size_t _mapped_bytes) noexcept
+        : base(_base), mapped_bytes(_mapped_bytes), header(reinterpret_cast<Header*>(_base)), capacity_cells(this->header->capacity) {}
+
+    static uint64_t* map_of(char* base) noexcept { return reinterpret_cast<uint64_t*>(base + sizeof(Header)); }
+
+    Cell& cell_at(uint64_t position) const noexcept {
+        std::size_t index = position % this->capacity_cells;
+        return reinterpret_cast<Cell*>(this->base + map_of(this->base)[index / initial_size])[index % initial_size];
+    }
+
+    /*Longest run of cells from `position` that stays inside one block and does not wrap*/
+    std::size_t contiguous_cells(uint64_t position, std::size_t count) const noexcept {
+        std::size_t index = position % this->capacity_cells;
+        return std::min<std::size_t>(count, initial_size - index % initial_size);
+    }
+
+public:
+    /*=============================================================^CONSTRUCTORS_AND_DESTRUCTORS^=============================================================*/
+
+    /*Creates the segment `name` ("/something") for at least `capacity` elements; throws std::system_error if it exists*/
+    static ShmDeque create(const std::string& name, std::size_t capacity) {
+        std::size_t block_count = std::max<std::size_t>(1, (capacity + initial_size - 1) / initial_size);
+        std::size_t blocks_begin = map_end(block_count);
+        std::size_t block_bytes = align_up(initial_size * sizeof(Cell), block_alignment);
+        std::size_t segment_bytes = blocks_begin + block_count * block_bytes;
+
+        int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) {
+            throw system_error("ShmDeque: shm_open " + name);
+        }
+        if (::ftruncate(fd, static_cast<off_t>(segment_bytes)) != 0) {
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            throw system_error("ShmDeque: ftruncate " + name);
+        }
+        void* memory = ::mmap(nullptr, segment_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (memory == MAP_FAILED) {
+            ::shm_unlink(name.c_str());
+            throw system_error("ShmDeque: mmap " + name);
+        }
+
+        char* base = static_cast<char*>(memory);
+        Header* header = reinterpret_cast<Header*>(base);
+        ::new (&header->magic) std::atomic<uint64_t>(0);
+        header->cell_size = sizeof(Cell);
+        header->producers = static_cast<uint64_t>(Producers);
+        header->capacity = block_count * initial_size;
+        header->block_count = block_count;
+        header->segment_bytes = segment_bytes;
+        ::new (&header->head) std::atomic<uint64_t>(0);
+        ::new (&header->tail) std::atomic<uint64_t>(0);
+        uint64_t* map = map_of(base);
+        for (std::size_t k = 0; k < block_count; k++) {
+            map[k] = blocks_begin + k * block_bytes;
+        }
+        if constexpr (Producers == ShmProducers::multiple) {
+            for (uint64_t position = 0; position < header->capacity; position++) {
+                SequencedCell* cells = reinterpret_cast<SequencedCell*>(base + map[position / initial_size]);
+                ::new (&cells[position % initial_size].sequence) std::atomic<uint64_t>(position);
+            }
+        }
+        header->magic.store(segment_magic, std::memory_order_release);
+
+        return ShmDeque(base, segment_bytes);
+    }
+
+    /* Maps an existing segment. Throws ShmDequeNotReady while its creator is still setting it up, and std::runtime_error if it
+     * was created for another T or producer mode*/
+    static ShmDeque open(const std::string& name) {
+        int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+        if (fd < 0) {
+            throw system_error("ShmDeque: shm_open " + name);
+        }
+        struct stat status;
+        if (::fstat(fd, &status) != 0) {
+            ::close(fd);
+            throw system_error("ShmDeque: fstat " + name);
+        }
+        std::size_t segment_bytes = static_cast<std::size_t>(status.st_size);
+        if (segment_bytes < sizeof(Header)) {
+            ::close(fd);
+            throw ShmDequeNotReady("ShmDeque: " + name + " is not initialized yet");
+        }
+        void* memory = ::mmap(nullptr, segment_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (memory == MAP_FAILED) {
+            throw system_error("ShmDeque: mmap " + name);
+        }
+
+        ShmDeque deque(static_cast<char*>(memory), segment_bytes);
+        const Header* header = deque.header;
+        uint64_t magic = header->magic.load(std::memory_order_acquire);
+        if (magic == 0) {
+            throw ShmDequeNotReady("ShmDeque: " + name + " is not initialized yet");
+        }
+        if (magic != segment_magic || header->cell_size != sizeof(Cell) || header->producers != static_cast<uint64_t>(Producers) ||
+            header->segment_bytes != segment_bytes) {
+            throw std::runtime_error("ShmDeque: " + name + " holds a different element type or producer mode");
+        }
+        deque.cached_head = header->head.load(std::memory_order_acquire);
+        deque.cached_tail = header->tail.load(std::memory_order_acquire);
+        return deque;
+    }
+
+    /*Removes the name; mappings stay valid until they are closed*/
+    static void unlink(const std::string& name) noexcept { ::shm_unlink(name.c_str()); }
+
+    ShmDeque(const ShmDeque&) = delete;
+    ShmDeque& operator=(const ShmDeque&) = delete;
+
+    ShmDeque(ShmDeque&& other) noexcept { this->swap(other); }
+
+    ShmDeque& operator=(ShmDeque&& other) noexcept {
+        this->swap(other);
+        return *this;
+    }
+
+    ~ShmDeque() {
+        if (this->base != nullptr) {
+            ::munmap(this->base, this->mapped_bytes);
+        }
+    }
+
+    void swap(ShmDeque& other) noexcept {
+        std::swap(this->base, other.base);
+        std::swap(this->mapped_bytes, other.mapped_bytes);
+        std::swap(this->header, other.header);
+        std::swap(this->capacity_cells, other.capacity_cells);
+        std::swap(this->cached_head, other.cached_head);
+        std::swap(this->cached_tail, other.cached_tail);
+    }
+
+    /*========================================================================^LOOKUP^========================================================================*/
+
+    std::size_t capacity() const noexcept { return this->capacity_cells; }
+
+    /*Number of elements at the moment of the call; only a hint while other processes are pushing or popping*/
+    std::size_t get_size() const noexcept {
+        uint64_t head = this->header->head.load(std::memory_order_acquire);
+        uint64_t tail = this->header->tail.load(std::memory_order_acquire);
+        return tail > head ? static_cast<std::size_t>(tail - head) : 0;
+    }
+
+    bool empty() const noexcept { return this->get_size() == 0; }
+
+    /*========================================================================^METHODS^=======================================================================*/
+
+    /*Adds value at the back; false if the ring is full*/
+    bool try_push(const T& value) noexcept {
+        if constexpr (Producers == ShmProducers::multiple) {
+            return this->try_push_sequenced(value);
+        } else {
+            uint64_t tail = this->header->tail.load(std::memory_order_relaxed);
+            if (tail - this->cached_head == this->capacity_cells) {
+                this->cached_head = this->header->head.load(std::memory_order_acquire);
+                if (tail - this->cached_head == this->capacity_cells) {
+                    return false;
+                }
+            }
+            std::memcpy(static_cast<void*>(&this->cell_at(tail).value), &value, sizeof(T));
+            this->header->tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+    }
+
+    /*Takes the front element into value; false if there is none (yet)*/
+    bool try_pop(T& value) noexcept {
+        if constexpr (Producers == ShmProducers::multiple) {
+            return this->try_pop_sequenced(value);
+        } else {
+            uint64_t head = this->header->head.load(std::memory_order_relaxed);
+            if (head == this->cached_tail) {
+                this->cached_tail = this->header->tail.load(std::memory_order_acquire);
+                if (head == this->cached_tail) {
+                    return false;
+                }
+            }
+            std::memcpy(static_cast<void*>(&value), &this->cell_at(head).value, sizeof(T));
+            this->header->head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+    }
+
+    /*Pushes as many of values[0, count) as fit; returns how many. With a single producer they are published at once*/
+    std::size_t push_span(const T* values, std::size_t count) noexcept {
+        if constexpr (Producers == ShmProducers::multiple) {
+            std::size_t pushed = 0;
+            while (pushed < count && this->try_push_sequenced(values[pushed])) {
+                pushed++;
+            }
+            return pushed;
+        }
+
+        uint64_t tail = this->header->tail.load(std::memory_order_relaxed);
+        if (tail + count - this->cached_head > this->capacity_cells) {
+            this->cached_head = this->header->head.load(std::memory_order_acquire);
+        }
+        count = std::min<std::size_t>(count, this->capacity_cells - (tail - this->cached_head));
+
+        for (std::size_t done = 0; done < count;) {
+            std::size_t chunk = this->contiguous_cells(tail + done, count - done);
+            Cell* cells = &this->cell_at(tail + done);
+            for (std::size_t i = 0; i < chunk; i++) {
+                std::memcpy(static_cast<void*>(&cells[i].value), values + done + i, sizeof(T));
+            }
+            done += chunk;
+        }
+        this->header->tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    /*Pops up to max_count elements into values; returns how many*/
+    std::size_t pop_batch(T* values, std::size_t max_count) noexcept {
+        if constexpr (Producers == ShmProducers::multiple) {
+            std::size_t popped = 0;
+            while (popped < max_count && this->try_pop_sequenced(values[popped])) {
+                popped++;
+            }
+            return popped;
+        }
+
+        uint64_t head = this->header->head.load(std::memory_order_relaxed);
+        if (this->cached_tail - head < max_count) {
+            this->cached_tail = this->header->tail.load(std::memory_order_acquire);
+        }
+        std::size_t count = std::min<std::size_t>(max_count, this->cached_tail - head);
+
+        for (std::size_t done = 0; done < count;) {
+            std::size_t chunk = this->contiguous_cells(head + done, count - done);
+            const Cell* cells = &this->cell_at(head + done);
+            for (std::size_t i = 0; i < chunk; i++) {
+                std::memcpy(static_cast<void*>(values + done + i), &cells[i].value, sizeof(T));
+            }
+            done += chunk;
+        }
+        this->header->head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+private:
+    bool try_push_sequenced(const T& value) noexcept {
+        uint64_t position = this->header->tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = this->cell_at(position);
+            uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+            int64_t lag = static_cast<int64_t>(sequence - position);
+            if (lag == 0) {
+                if (this->header->tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    std::memcpy(static_cast<void*>(&cell.value), &value, sizeof(T));
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false;                                        // The consumer has not freed this cell yet: full.
+            } else {
+                position = this->header->tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_pop_sequenced(T& value) noexcept {
+        uint64_t position = this->header->head.load(std::memory_order_relaxed);
+        Cell& cell = this->cell_at(position);
+        if (cell.sequence.load(std::memory_order_acquire) != position + 1) {
+            return false;                                            // Empty, or the producer is still writing it.
+        }
+        std::memcpy(static_cast<void*>(&value), &cell.value, sizeof(T));
+        cell.sequence.store(position + this->capacity_cells, std::memory_order_release);
+        this->header->head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+#endif  // SRC_SHM_DEQUE_HPP_
@@ -0,0 +1,114 @@
+#ifndef SRC_SORTED_DEQUE_HPP_
+#define SRC_SORTED_DEQUE_HPP_
+
+#include <algorithm>
+#include <functional>
+
+#include "Deque.hpp"
+
+/*Deque kept in Cmp order. Lookups binary-search the blocks by their last element and then the elements of one block, so a search
+ * touches O(log blocks) block ends plus one contiguous block. Inserting goes through Deque::insert, which shifts only the shorter
+ * side: a late arrival that lands k elements before the back costs O(k), an in-order one is a plain push_back. Equal elements keep
+ * their arrival order (new ones go after the existing ones).*/
+template <typename T, typename Cmp = std::less<T>>
+class SortedDeque {
+private:
+    Deque<T> storage;
+    Cmp cmp;
+
+    /*First position whose element e satisfies past(e); past must be monotone over the sorted sequence*/
+    template <typename Past>
+    std::size_t partition_point(Past past) const {
+        std::size_t low = 0;
+        std::size_t high = this->storage.segment_count();
+
+        while (low < high) {                                        // First segment whose last element is past the probe.
+            std::size_t middle = low + (high - low) / 2;
+            auto segment = this->storage.segment(middle);
+            if (past(segment.data[segment.size - 1])) {
+                high = middle;
+            } else {
+                low = middle + 1;
+            }
+        }
+
+        if (low == this->storage.segment_count()) {
+            return this->storage.get_size();
+        }
+
+        auto segment = this->storage.segment(low);
+        const T* found = std::partition_point(segment.begin(), segment.end(), [&past](const T& value) { return !past(value); });
+        return this->storage.segment_offset(low) + static_cast<std::size_t>(found - segment.begin());
+    }
+
+public:
+    explicit SortedDeque(Cmp _cmp = Cmp()) : cmp(_cmp) {}
+
+    /*========================================================================^LOOKUP^========================================================================*/
+
+    std::size_t get_size() const noexcept { return this->storage.get_size(); }
+
+    bool empty() const noexcept { return this->storage.empty(); }
+
+    const T& operator[](std::size_t index) const { return this->storage[index]; }
+
+    const T& front() const { return this->storage[0]; }
+
+    const T& back() const { return this->storage[this->storage.get_size() - 1]; }
+
+    /*Index of the first element not ordered before value*/
+    std::size_t lower_bound(const T& value) const {
+        return this->partition_point([this, &value](const T& element) { return !this->cmp(element, value); });
+    }
+
+    /*Index of the first element ordered after value*/
+    std::size_t upper_bound(const T& value) const {
+        return this->partition_point([this, &value](const T& element) { return this->cmp(value, element); });
+    }
+
+    std::size_t count(const T& value) const { return this->upper_bound(value) - this->lower_bound(value); }
+
+    bool contains(const T& value) const {
+        std::size_t index = this->lower_bound(value);
+        return index < this->get_size() && !this->cmp(value, this->storage[index]);
+    }
+
+    /*Read-only access to the underlying blocks*/
+    const Deque<T>& deque() const noexcept { return this->storage; }
+
+    /*========================================================================^METHODS^=======================================================================*/
+
+    /*Inserts in order and returns the index the element landed at*/
+    std::size_t insert(const T& value) {
+        if (this->empty() || !this->cmp(value, this->back())) {     // In-order arrival, the common case.
+            this->storage.push_back(value);
+            return this->get_size() - 1;
+        }
+        if (this->cmp(value, this->front())) {
+            this->storage.push_front(value);
+            return 0;
+        }
+
+        std::size_t index = this->upper_bound(value);
+        this->storage.insert(this->storage.begin() + index, value);
+        return index;
+    }
+
+    void erase(std::size_t index) { this->storage.erase(this->storage.begin() + index); }
+
+    /*Removes one element equal to value, if there is one*/
+    bool erase_value(const T& value) {
+        std::size_t index = this->lower_bound(value);
+        if (index == this->get_size() || this->cmp(value, this->storage[index])) {
+            return false;
+        }
+        this->erase(index);
+        return true;
+    }
+
+    void pop_front() { this->storage.pop_front(); }
+
+    void pop_back() { this->storage.pop_back(); }
+};
+
+#endif  // SRC_SORTED_DEQUE_HPP_
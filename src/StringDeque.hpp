@@ -0,0 +1,271 @@
+#ifndef SRC_STRING_DEQUE_HPP_
+#define SRC_STRING_DEQUE_HPP_
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+
+#include "Deque.hpp"
+
+/* Deque of strings that owns the characters itself. Deque<std::string> allocates a buffer per string (past the SSO limit) and a
+ * scan chases one pointer per element; here the bytes of all strings in one block of `entries` are copied into that block's
+ * character arena, and the entry only records {offset, length} inside it.
+ *
+ * The arenas are aligned with the segments of `entries` the way IndexedDeque aligns its bounds: arena k belongs to segment k, a
+ * segment appearing adds an arena at that end and a segment draining drops it. Offsets are relative, so an arena grows by
+ * reallocation without touching its entries. Dropped arenas are kept as spares (one per end) and reused by the next block, so
+ * a queue that keeps its length stops allocating once warm. Bytes of strings popped from the middle of an arena are reclaimed
+ * only when the whole block drains.
+ *
+ * Access returns std::string_view into the arena: valid until that string is popped or its block's arena grows.*/
+template <typename BlockAllocator>
+class BasicStringDeque {
+    static_assert(!block_allocator_has_context<BlockAllocator>::value, "BasicStringDeque calls its policy without a context");
+
+private:
+    struct Entry {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    struct Arena {
+        char* bytes = nullptr;
+        uint32_t used = 0;
+        uint32_t capacity = 0;
+    };
+
+    const static std::size_t block_strings = DequeCore::initial_size;
+    const static uint32_t initial_arena_bytes = 2048;
+    const static std::size_t spare_limit = 2;
+
+    Deque<Entry, BlockAllocator> entries;
+    Deque<Arena, BlockAllocator> arenas;                             // arenas[k] holds the bytes of entries.segment(k).
+    Arena spares[spare_limit];
+    std::size_t spare_count = 0;
+
+    Arena take_arena() noexcept { return this->spare_count > 0 ? this->spares[--this->spare_count] : Arena(); }
+
+    void drop_arena(Arena arena) noexcept {
+        if (arena.bytes == nullptr) {
+            return;
+        }
+        if (this->spare_count < spare_limit) {
+            arena.used = 0;
+            this->spares[this->spare_count++] = arena;
+        } else {
+            BlockAllocator::deallocate(arena.bytes, arena.capacity);
+        }
+    }
+
+    /*Copies text to the end of the arena, growing it by reallocation; returns the offset*/
+    static uint32_t append(Arena& arena, std::string_view text) {
+        const std::size_t limit = std::numeric_limits<uint32_t>::max();
+        if (text.size() > limit - arena.used) {
+            throw std::length_error("StringDeque: block arena exceeds 4 GiB");
+        }
+        std::size_t required = arena.used + text.size();
+        if (required > arena.capacity) {
+            std::size_t capacity = std::max<std::size_t>({initial_arena_bytes, std::size_t(arena.capacity) * 2, required});
+            capacity = std::min(capacity, limit);
+            char* bytes = static_cast<char*>(BlockAllocator::allocate(capacity));
+            if (arena.bytes != nullptr) {
+                std::memcpy(bytes, arena.bytes, arena.used);
+                BlockAllocator::deallocate(arena.bytes, arena.capacity);
+            }
+            arena.bytes = bytes;
+            arena.capacity = static_cast<uint32_t>(capacity);
+        }
+        uint32_t offset = arena.used;
+        if (!text.empty()) {
+            std::memcpy(arena.bytes + offset, text.data(), text.size());
+        }
+        arena.used = static_cast<uint32_t>(required);
+        return offset;
+    }
+
+    /*The string was the last one written to its arena: give its bytes back*/
+    static void reclaim(Arena& arena, Entry entry) noexcept {
+        if (entry.offset + entry.length == arena.used) {
+            arena.used = entry.offset;
+        }
+    }
+
+    void check_index(std::size_t index, const char* message) const {
+        if (index >= this->entries.get_size()) {
+            throw std::out_of_range(message);
+        }
+    }
+
+public:
+    /*=============================================================^CONSTRUCTORS_AND_DESTRUCTORS^=============================================================*/
+
+    BasicStringDeque() = default;
+
+    BasicStringDeque(const BasicStringDeque& other) : BasicStringDeque() {
+        for (std::size_t i = 0; i < other.get_size(); i++) {
+            this->push_back(other[i]);
+        }
+    }
+
+    BasicStringDeque(BasicStringDeque&& other) noexcept
+        : entries(std::move(other.entries)), arenas(std::move(other.arenas)), spare_count(other.spare_count) {
+        std::copy(other.spares, other.spares + this->spare_count, this->spares);
+        other.spare_count = 0;                                      // The spare arenas changed owner.
+    }
+
+    BasicStringDeque& operator=(BasicStringDeque other) noexcept {
+        this->swap(other);
+        return *this;
+    }
+
+    ~BasicStringDeque() {
+        this->clear();
+        for (std::size_t i = 0; i < this->spare_count; i++) {
+            BlockAllocator::deallocate(this->spares[i].bytes, this->spares[i].capacity);
+        }
+    }
+
+    void swap(BasicStringDeque& other) noexcept {
+        this->entries.swap(other.entries);
+        this->arenas.swap(other.arenas);
+        std::swap(this->spares, other.spares);
+        std::swap(this->spare_count, other.spare_count);
+    }
+
+    /*========================================================================^LOOKUP^========================================================================*/
+
+    std::size_t get_size() const noexcept { return this->entries.get_size(); }
+
+    bool empty() const noexcept { return this->entries.empty(); }
+
+    /*Access string `index`, bounds checked only with DEQUE_CHECKED*/
+    std::string_view operator[](std::size_t index) const {
+#ifdef DEQUE_CHECKED
+        this->check_index(index, "StringDeque::operator[]: index out of range");
+#endif
+        const Entry& entry = this->entries[index];
+        const Arena& arena = this->arenas[this->entries.segment_of(index)];
+        return std::string_view(arena.bytes + entry.offset, entry.length);
+    }
+
+    std::string_view at(std::size_t index) const {
+        this->check_index(index, "StringDeque::at: index out of range");
+        return (*this)[index];
+    }
+
+    std::string_view front() const {
+        assert(!this->empty());
+        return (*this)[0];
+    }
+
+    std::string_view back() const {
+        assert(!this->empty());
+        return (*this)[this->get_size() - 1];
+    }
+
+    /*Calls f(std::string_view) for every string in order, one arena at a time*/
+    template <typename F>
+    void for_each(F f) const {
+        std::size_t k = 0;
+        this->entries.for_each_segment([this, &f, &k](DequeSegment<const Entry*> segment) {
+            const char* bytes = this->arenas[k++].bytes;
+            for (const Entry& entry : segment) {
+                f(std::string_view(bytes + entry.offset, entry.length));
+            }
+        });
+    }
+
+    /*Entries, arena map and the arena bytes (including spares)*/
+    DequeMemoryUsage memory_usage() const noexcept {
+        DequeMemoryUsage usage = this->entries.memory_usage();
+        DequeMemoryUsage arena_usage = this->arenas.memory_usage();
+        usage.map_bytes += arena_usage.total();
+        for (std::size_t k = 0; k < this->arenas.get_size(); k++) {
+            usage.live_block_bytes += this->arenas[k].capacity;
+        }
+        for (std::size_t i = 0; i < this->spare_count; i++) {
+            usage.idle_block_bytes += this->spares[i].capacity;
+        }
+        return usage;
+    }
+
+    /*========================================================================^METHODS^=======================================================================*/
+
+    void push_back(std::string_view text) {
+        std::size_t size = this->entries.get_size();
+        bool new_block = size == 0 || (this->entries.front_position() + size) % block_strings == 0;
+        if (new_block) {
+            this->arenas.push_back(this->take_arena());
+        }
+        try {
+            uint32_t offset = append(this->arenas.back(), text);
+            this->entries.push_back(Entry{offset, static_cast<uint32_t>(text.size())});
+        } catch (...) {
+            if (new_block) {
+                this->drop_arena(this->arenas.back());
+                this->arenas.pop_back();
+            }
+            throw;
+        }
+    }
+
+    void push_front(std::string_view text) {
+        bool new_block = this->entries.empty() || this->entries.front_position() % block_strings == 0;
+        if (new_block) {
+            this->arenas.push_front(this->take_arena());
+        }
+        try {
+            uint32_t offset = append(this->arenas.front(), text);
+            this->entries.push_front(Entry{offset, static_cast<uint32_t>(text.size())});
+        } catch (...) {
+            if (new_block) {
+                this->drop_arena(this->arenas.front());
+                this->arenas.pop_front();
+            }
+            throw;
+        }
+    }
+
+    void pop_front() {
+        if (this->empty()) {
+            return;
+        }
+        std::size_t segments = this->entries.segment_count();
+        reclaim(this->arenas.front(), this->entries.front());
+        this->entries.pop_front();
+        if (this->entries.segment_count() < segments) {
+            this->drop_arena(this->arenas.front());
+            this->arenas.pop_front();
+        }
+    }
+
+    void pop_back() {
+        if (this->empty()) {
+            return;
+        }
+        std::size_t segments = this->entries.segment_count();
+        reclaim(this->arenas.back(), this->entries.back());
+        this->entries.pop_back();
+        if (this->entries.segment_count() < segments) {
+            this->drop_arena(this->arenas.back());
+            this->arenas.pop_back();
+        }
+    }
+
+    /*Removes every string; up to two arenas stay as spares*/
+    void clear() noexcept {
+        while (!this->arenas.empty()) {
+            this->drop_arena(this->arenas.back());
+            this->arenas.pop_back();
+        }
+        this->entries.clear();
+    }
+};
+
+using StringDeque = BasicStringDeque<DefaultBlockAllocator>;
+
+#endif  // SRC_STRING_DEQUE_HPP_
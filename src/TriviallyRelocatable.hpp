@@ -0,0 +1,30 @@
+#ifndef SRC_TRIVIALLY_RELOCATABLE_HPP_
+#define SRC_TRIVIALLY_RELOCATABLE_HPP_
+
+#include <memory>
+#include <type_traits>
+
+/*Opt-in trait in the shape of P1144: a type is trivially relocatable when "move-construct into new storage, then destroy the
+ * source" has exactly the effect of copying its bytes. Deque then moves such elements with memmove instead of one move and one
+ * destructor call per element.
+ *
+ * Trivially copyable types qualify automatically. Everything else has to opt in, either by specializing the trait or with
+ * DEQUE_TRIVIALLY_RELOCATABLE(Type) at namespace scope. Only opt in types that hold no pointer into themselves: libstdc++'s
+ * std::string points at its own small buffer and must NOT be marked, while std::unique_ptr and std::shared_ptr are safe.*/
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+struct is_trivially_relocatable<std::unique_ptr<T, std::default_delete<T>>> : std::true_type {};
+
+template <typename T>
+struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+#define DEQUE_TRIVIALLY_RELOCATABLE(Type) \
+    template <>                           \
+    struct is_trivially_relocatable<Type> : std::true_type {}
+
+#endif  // SRC_TRIVIALLY_RELOCATABLE_HPP_
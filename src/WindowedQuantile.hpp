@@ -0,0 +1,232 @@
+#ifndef SRC_WINDOWED_QUANTILE_HPP_
+#define SRC_WINDOWED_QUANTILE_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+
+#include "Deque.hpp"
+
+/*Order statistics over the last `window` samples: push() adds a sample and expires the oldest once the window is full, and
+ * quantile()/select() answer from an indexable skiplist instead of sorting the window per query. Updates and queries are O(log n)
+ * expected.
+ *
+ * Samples expire in arrival order, so the skiplist nodes live in Deques in that order: `entries` holds the values and the links of
+ * level l sit in `levels[l]`, one per node tall enough to reach it. Inserting pushes to the back of each, expiring pops the same
+ * fronts, so node addresses stay put and a full window reuses its drained blocks instead of allocating. A link records how many
+ * level-0 steps it spans (its width), which is what turns the skiplist into a rank index. Equal samples are ordered by arrival,
+ * so the expired node is found exactly with one search.
+ *
+ * For time-based windows, call pop_oldest() while oldest() is too old; the window size then only bounds memory.*/
+template <typename T, typename Cmp = std::less<T>>
+class WindowedQuantile {
+private:
+    /*p = 1/4 per level, so 16 levels keep searches logarithmic up to 4^16 samples*/
+    static const std::size_t max_levels = 16;
+
+    struct Entry {
+        T value;
+        uint64_t sequence;
+        std::size_t height;
+    };
+
+    struct Link {
+        Link* next;
+        Link* down;
+        std::size_t width;                                          // Level-0 steps to next; meaningless while next is null.
+        const Entry* entry;
+    };
+
+    Deque<Entry> entries;
+    std::array<Deque<Link>, max_levels> levels;
+    std::array<Link, max_levels> head;
+    std::size_t height = 0;                                         // Levels in use; head links above it are unused.
+    std::size_t capacity;
+    uint64_t sequence = 0;
+    uint64_t random_state = 0x9e3779b97f4a7c15ULL;
+    Cmp cmp;
+
+    /*Strict order on (value, arrival), so every node has a unique place*/
+    bool before(const Entry& a, const Entry& b) const {
+        if (this->cmp(a.value, b.value)) return true;
+        if (this->cmp(b.value, a.value)) return false;
+        return a.sequence < b.sequence;
+    }
+
+    std::size_t random_height() noexcept {
+        this->random_state ^= this->random_state >> 12;             // xorshift64*
+        this->random_state ^= this->random_state << 25;
+        this->random_state ^= this->random_state >> 27;
+        uint64_t bits = (this->random_state * 0x2545f4914f6cdd1dULL) >> 32;
+
+        std::size_t result = 1;
+        while ((bits & 3) == 0 && result < max_levels) {
+            bits >>= 2;
+            result++;
+        }
+        return result;
+    }
+
+    void reset_head() noexcept {
+        for (std::size_t level = 0; level < max_levels; level++) {
+            this->head[level] = Link{nullptr, level == 0 ? nullptr : &this->head[level - 1], 0, nullptr};
+        }
+        this->height = 0;
+    }
+
+    /*Last link before `key` on every level in use, and its level-0 position (0 is the head, i is the i-th smallest sample)*/
+    void find_predecessors(const Entry& key, Link** chain, std::size_t* positions) const {
+        Link* link = const_cast<Link*>(&this->head[this->height - 1]);
+        std::size_t position = 0;
+        for (std::size_t level = this->height; level-- > 0;) {
+            while (link->next != nullptr && this->before(*link->next->entry, key)) {
+                position += link->width;
+                link = link->next;
+            }
+            chain[level] = link;
+            positions[level] = position;
+            link = link->down;
+        }
+    }
+
+    void insert(const Entry& entry) {
+        Link* chain[max_levels];
+        std::size_t positions[max_levels];
+        if (this->height > 0) {
+            this->find_predecessors(entry, chain, positions);
+        }
+        for (std::size_t level = this->height; level < entry.height; level++) {
+            chain[level] = &this->head[level];
+            positions[level] = 0;
+        }
+        std::size_t position = this->height > 0 ? positions[0] : 0;
+
+        Link* below = nullptr;
+        for (std::size_t level = 0; level < entry.height; level++) {
+            Link* previous = chain[level];
+            std::size_t distance = position - positions[level];    // Level-0 steps from previous to the new node's predecessor.
+            Link& link = this->levels[level].emplace_back(Link{previous->next, below, previous->width - distance, &entry});
+            previous->next = &link;
+            previous->width = distance + 1;
+            below = &link;
+        }
+        for (std::size_t level = entry.height; level < this->height; level++) {
+            chain[level]->width++;
+        }
+        this->height = std::max(this->height, entry.height);
+    }
+
+public:
+    explicit WindowedQuantile(std::size_t window, Cmp _cmp = Cmp()) : capacity(window), cmp(_cmp) {
+        if (window == 0) {
+            throw std::invalid_argument("WindowedQuantile: window must hold at least one sample");
+        }
+        this->reset_head();
+    }
+
+    /*Links point into the Deques and at the head*/
+    WindowedQuantile(const WindowedQuantile&) = delete;
+    WindowedQuantile& operator=(const WindowedQuantile&) = delete;
+
+    /*========================================================================^LOOKUP^========================================================================*/
+
+    std::size_t get_size() const noexcept { return this->entries.get_size(); }
+
+    bool empty() const noexcept { return this->entries.empty(); }
+
+    std::size_t window() const noexcept { return this->capacity; }
+
+    /*Least recently pushed sample, the next one to expire*/
+    const T& oldest() const { return this->entries[0].value; }
+
+    const T& newest() const { return this->entries[this->entries.get_size() - 1].value; }
+
+    /*The rank-th smallest sample, from 0*/
+    const T& select(std::size_t rank) const {
+        if (rank >= this->get_size()) {
+            throw std::out_of_range("WindowedQuantile::select: rank out of range");
+        }
+        const Link* link = &this->head[this->height - 1];
+        std::size_t remaining = rank + 1;
+        for (std::size_t level = this->height; level-- > 0;) {
+            while (link->next != nullptr && link->width <= remaining) {
+                remaining -= link->width;
+                link = link->next;
+            }
+            if (level > 0) {
+                link = link->down;
+            }
+        }
+        return link->entry->value;
+    }
+
+    /*Nearest-rank quantile: the smallest sample with at least q of the window at or below it; q = 0 is the minimum*/
+    const T& quantile(double q) const {
+        if (this->empty() || !(q >= 0 && q <= 1)) {
+            throw std::out_of_range("WindowedQuantile::quantile: empty window or q outside [0, 1]");
+        }
+        std::size_t rank = static_cast<std::size_t>(std::ceil(q * static_cast<double>(this->get_size())));
+        return this->select(rank == 0 ? 0 : std::min(rank, this->get_size()) - 1);
+    }
+
+    /*Number of samples ordered before value, e.g. the requests that met a latency target*/
+    std::size_t count_less(const T& value) const {
+        if (this->empty()) {
+            return 0;
+        }
+        const Link* link = &this->head[this->height - 1];
+        std::size_t count = 0;
+        for (std::size_t level = this->height; level-- > 0;) {
+            while (link->next != nullptr && this->cmp(link->next->entry->value, value)) {
+                count += link->width;
+                link = link->next;
+            }
+            link = link->down;
+        }
+        return count;
+    }
+
+    /*========================================================================^METHODS^=======================================================================*/
+
+    /*Adds a sample, first expiring the oldest one if the window is full*/
+    void push(const T& value) {
+        if (this->get_size() == this->capacity) {
+            this->pop_oldest();
+        }
+        this->insert(this->entries.emplace_back(Entry{value, this->sequence++, this->random_height()}));
+    }
+
+    void pop_oldest() {
+        if (this->empty()) {
+            throw std::out_of_range("WindowedQuantile::pop_oldest: window is empty");
+        }
+        const Entry& entry = this->entries.front();
+        Link* chain[max_levels];
+        std::size_t positions[max_levels];
+        this->find_predecessors(entry, chain, positions);
+
+        for (std::size_t level = 0; level < entry.height; level++) {
+            Link* target = chain[level]->next;                     // The oldest node's link is the oldest on its level.
+            chain[level]->width += target->width - 1;
+            chain[level]->next = target->next;
+            this->levels[level].pop_front();
+        }
+        for (std::size_t level = entry.height; level < this->height; level++) {
+            chain[level]->width--;
+        }
+        this->entries.pop_front();
+    }
+
+    void clear() noexcept {
+        this->entries.clear();
+        for (Deque<Link>& level : this->levels) {
+            level.clear();
+        }
+        this->reset_head();
+    }
+};
+
+#endif  // SRC_WINDOWED_QUANTILE_HPP_
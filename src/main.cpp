@@ -4,7 +4,7 @@
 #include <stdlib.h>
 #include <vector>
 
-#include "Deque.hpp"
+#include "DequeExtern.hpp"
 
 using namespace std::chrono;
 
@@ -40,7 +40,7 @@ void testing_with_stl_push_back() {
 
     auto start_clock_stl = high_resolution_clock::now();
     for (std::size_t i = 0; i < 10000; i++) {
-        deque->push_back(v[i]);
+        stl_deque->push_back(v[i]);
     }
     auto stop_clock_stl = high_resolution_clock::now();
     auto duration_stl = stop_clock_stl - start_clock_stl;
@@ -70,7 +70,7 @@ void testing_with_stl_push_front() {
 
     auto start_clock_stl = high_resolution_clock::now();
     for (std::size_t i = 0; i < 10000; i++) {
-        deque->push_front(v[i]);
+        stl_deque->push_front(v[i]);
     }
     auto stop_clock_stl = high_resolution_clock::now();
     auto duration_stl = stop_clock_stl - start_clock_stl;
@@ -84,7 +84,7 @@ void testing_push_pop() {
     auto deque = new Deque<int>;
     auto stl_deque = new std::deque<int>;
 
-    for (int i = 0; i < v.size(); i++) {
+    for (std::size_t i = 0; i < v.size(); i++) {
         deque->push_back(v[i]);
         stl_deque->push_back(v[i]);
     }
@@ -95,7 +95,7 @@ void testing_push_pop() {
         assert(*it == *my_it);
     }
 
-    for (int i = v.size() - 1; i >= 0; i--) {
+    for (int i = static_cast<int>(v.size()) - 1; i >= 0; i--) {
         deque->push_front(v[i]);
         stl_deque->push_front(v[i]);
     }
@@ -0,0 +1,133 @@
+/* ArenaDeque: blocks and maps come from the scoped arena, nothing goes back until release(), and release() keeps the next
+ * request on a single chunk. */
+
+#undef NDEBUG
+
+#include <cassert>
+#include <deque>
+#include <stdexcept>
+#include <string>
+
+#include "../src/ArenaDeque.hpp"
+
+namespace {
+
+void test_growth_and_pops_never_free() {
+    DequeArena arena(4096);
+    DequeArena::Scope scope(arena);
+
+    ArenaDeque<int> deque;
+    std::deque<int> model;
+    std::size_t used = arena.bytes_used();
+    assert(used > 0);
+
+    for (int i = 0; i < 5000; i++) {
+        deque.push_back(i);
+        deque.push_front(-i);
+        model.push_back(i);
+        model.push_front(-i);
+        assert(arena.bytes_used() >= used);                          // Map resizes only ever add.
+        used = arena.bytes_used();
+    }
+    for (int i = 0; i < 7000; i++) {
+        deque.pop_front();
+        model.pop_front();
+    }
+    deque.shrink_to_fit();
+    assert(arena.bytes_used() == used);
+
+    assert(deque.get_size() == model.size());
+    for (std::size_t i = 0; i < model.size(); i++) assert(deque[i] == model[i]);
+}
+
+void test_release_keeps_one_chunk() {
+    DequeArena arena(1024);
+    DequeArena::Scope scope(arena);
+
+    for (int request = 0; request < 3; request++) {
+        {
+            ArenaDeque<std::string> deque;                           // Non-trivial T: destroyed before release.
+            for (int i = 0; i < 2000; i++) deque.push_back(std::to_string(i));
+            assert(deque.back() == "1999");
+        }
+        if (request > 0) {
+            assert(arena.chunk_count() == 1);
+        }
+        arena.release();
+        assert(arena.bytes_used() == 0);
+    }
+}
+
+void test_scopes() {
+    assert(DequeArena::current() == nullptr);
+    bool thrown = false;
+    try {
+        ArenaDeque<int> deque;
+    } catch (const std::logic_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    DequeArena outer;
+    DequeArena inner;
+    {
+        DequeArena::Scope outer_scope(outer);
+        {
+            DequeArena::Scope inner_scope(inner);
+            ArenaDeque<int> deque;
+            assert(inner.bytes_used() > 0 && outer.bytes_used() == 0);
+        }
+        assert(DequeArena::current() == &outer);
+    }
+    assert(DequeArena::current() == nullptr);
+}
+
+/*The arena is bound at construction: moves and growth outside the scope keep using it, and never a later scope's*/
+void test_deque_outlives_scope() {
+    DequeArena first;
+    DequeArena second;
+    ArenaDeque<int> deque = [&] {
+        DequeArena::Scope scope(first);
+        ArenaDeque<int> made;
+        made.push_back(0);
+        return made;
+    }();
+    assert(DequeArena::current() == nullptr);
+
+    ArenaDeque<int> moved(std::move(deque));                         // Outside any scope: must not allocate or throw.
+    for (int i = 1; i < 5000; i++) moved.push_back(i);
+    deque.push_back(-1);                                             // The moved-from deque still allocates from `first`.
+    assert(deque.get_size() == 1 && deque.front() == -1);
+    assert(moved.get_size() == 5000 && moved.back() == 4999);
+
+    std::size_t used = first.bytes_used();
+    {
+        DequeArena::Scope scope(second);
+        for (int i = 0; i < 5000; i++) moved.push_front(i);
+        ArenaDeque<int> tail = moved.split_at(7000);                 // Same arena as moved.
+        ArenaDeque<int> copy(tail);
+        for (int i = 0; i < 5000; i++) copy.push_back(i);
+        assert(second.bytes_used() == 0);
+
+        ArenaDeque<int> local;                                       // Blocks stay in their own arena across a splice.
+        for (int i = 0; i < 100; i++) local.push_back(i);
+        local.splice_back(std::move(copy));
+        assert(local.get_size() == 100 + 3000 + 5000 && copy.empty());
+        std::size_t local_used = second.bytes_used();
+        moved.splice_back(std::move(local));
+        assert(moved.get_size() == 7000 + 8100 && local.empty());
+        assert(second.bytes_used() == local_used);
+    }
+    assert(first.bytes_used() > used);
+    for (std::size_t i = 0; i < 5000; i++) assert(moved[i] == static_cast<int>(4999 - i));
+    assert(moved[7000] == 0 && moved[7099] == 99 && moved.back() == 4999);
+}
+
+}  // namespace
+
+int main() {
+    test_growth_and_pops_never_free();
+    test_release_keeps_one_chunk();
+    test_scopes();
+    test_deque_outlives_scope();
+}
@@ -0,0 +1,109 @@
+/* CachedBlockAllocator: size classes, reuse within a thread, hand-over through the central pool when a thread exits, and deque
+ * construct/destroy churn that stops reaching operator new once the cache is warm. */
+
+#undef NDEBUG
+
+#include <cassert>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "../src/Deque.hpp"
+
+namespace {
+
+std::size_t new_calls = 0;
+
+}  // namespace
+
+/*Counts what reaches the heap. gcc sees operator new inline into callers and then flags free() on its result*/
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void* operator new(std::size_t bytes) {
+    new_calls++;
+    if (void* storage = std::malloc(bytes == 0 ? 1 : bytes)) {
+        return storage;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* storage) noexcept { std::free(storage); }
+
+void operator delete(void* storage, std::size_t) noexcept { std::free(storage); }
+
+#pragma GCC diagnostic pop
+
+namespace {
+
+void test_size_classes() {
+    using Cache = CachedBlockAllocator;
+    assert(Cache::class_of(1) == 0 && Cache::class_bytes(0) == 64);
+    assert(Cache::class_bytes(Cache::class_of(Cache::max_bytes)) == Cache::max_bytes);
+    assert(Cache::class_of(Cache::max_bytes + 1) == Cache::class_count);
+
+    for (std::size_t bytes = 1; bytes <= 70000; bytes++) {
+        std::size_t c = Cache::class_of(bytes);
+        assert(Cache::class_bytes(c) >= bytes);                     // Fits,
+        assert(c == 0 || Cache::class_bytes(c - 1) < bytes);        // and the class is the smallest that does,
+        assert(bytes <= 64 || Cache::class_bytes(c) * 4 <= bytes * 5);  // with at most 25% slack.
+    }
+}
+
+void test_thread_reuse() {
+    void* first = CachedBlockAllocator::allocate(256 * sizeof(int));
+    CachedBlockAllocator::deallocate(first, 256 * sizeof(int));
+    void* second = CachedBlockAllocator::allocate(250 * sizeof(int));  // Same class.
+    assert(second == first);
+    CachedBlockAllocator::deallocate(second, 250 * sizeof(int));
+}
+
+void test_churn_skips_operator_new() {
+    for (int round = 0; round < 2; round++) {                        // First round warms the cache.
+        std::size_t before = new_calls;
+        for (int i = 0; i < 1000; i++) {
+            Deque<int, CachedBlockAllocator> deque;               // Explicit: DEQUE_NO_BLOCK_CACHE builds default to the heap.
+            for (int k = 0; k < 300; k++) deque.push_back(k);
+            assert(deque.back() == 299);
+        }
+        if (round == 1) {
+            assert(new_calls == before);
+        }
+    }
+}
+
+void test_exiting_thread_hands_blocks_over() {
+    std::size_t central_before = CachedBlockAllocator::central_blocks();
+    std::thread([] {
+        std::vector<Deque<double, CachedBlockAllocator>> deques(8);
+        for (auto& deque : deques) {
+            for (int k = 0; k < 1000; k++) deque.push_back(k);
+        }
+    }).join();
+    assert(CachedBlockAllocator::central_blocks() > central_before);
+
+    std::size_t before = new_calls;
+    {
+        Deque<double, CachedBlockAllocator> deque;                   // Refills from the central pool.
+        for (int k = 0; k < 1000; k++) deque.push_back(k);
+    }
+    assert(new_calls == before);
+}
+
+void test_bounded_thread_cache() {
+    std::vector<void*> blocks;
+    for (std::size_t i = 0; i < 10 * CachedBlockAllocator::thread_limit; i++) blocks.push_back(CachedBlockAllocator::allocate(4096));
+    for (void* block : blocks) CachedBlockAllocator::deallocate(block, 4096);
+    assert(CachedBlockAllocator::thread_cached_blocks() <= CachedBlockAllocator::class_count * CachedBlockAllocator::thread_limit);
+}
+
+}  // namespace
+
+int main() {
+    test_size_classes();
+    test_thread_reuse();
+    test_churn_skips_operator_new();
+    test_exiting_thread_hands_blocks_over();
+    test_bounded_thread_cache();
+}
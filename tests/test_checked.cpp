@@ -0,0 +1,90 @@
+/* DEQUE_CHECKED mode: out of range access throws instead of reading another slot, and iterators are rejected once the deque
+ * changed shape under them. */
+
+#undef NDEBUG
+#ifndef DEQUE_CHECKED
+#define DEQUE_CHECKED
+#endif
+
+#include <cassert>
+#include <stdexcept>
+
+#include "../src/Deque.hpp"
+
+namespace {
+
+template <typename Exception, typename Action>
+bool throws(Action action) {
+    try {
+        action();
+    } catch (const Exception&) {
+        return true;
+    }
+    return false;
+}
+
+void test_bounds() {
+    Deque<int> deque;
+    assert(throws<std::out_of_range>([&] { deque.front(); }));
+    assert(throws<std::out_of_range>([&] { deque.back(); }));
+    assert(throws<std::out_of_range>([&] { deque[0]; }));
+
+    for (int i = 0; i < 100; i++) deque.push_back(i);
+    assert(deque[99] == 99 && deque.front() == 0 && deque.back() == 99);
+    assert(throws<std::out_of_range>([&] { deque[100]; }));
+    assert(throws<std::out_of_range>([&] { deque.at(100); }));
+    assert(throws<std::out_of_range>([&] { *deque.end(); }));
+
+    const Deque<int>& view = deque;
+    assert(throws<std::out_of_range>([&] { view[static_cast<std::size_t>(-1)]; }));
+}
+
+void test_iterator_invalidation() {
+    Deque<int> deque;
+    for (int i = 0; i < 10; i++) deque.push_back(i);
+
+    auto it = deque.begin() + 3;
+    assert(*it == 3);
+    assert(*(it + 1) == 4);
+
+    deque.push_front(-1);                                          // Shifts every index: `it` would now read 2.
+    assert(throws<std::logic_error>([&] { *it; }));
+    assert(throws<std::logic_error>([&] { deque.erase(it); }));
+
+    it = deque.begin() + 3;
+    deque.erase(it);                                               // A fresh iterator is fine, and erase invalidates it again.
+    assert(throws<std::logic_error>([&] { *it; }));
+
+    auto before_resize = deque.begin();
+    for (int i = 0; i < 1000; i++) deque.push_back(i);             // Grows the map.
+    assert(throws<std::logic_error>([&] { *before_resize; }));
+
+    Deque<int> other;
+    other.push_back(1);
+    assert(throws<std::logic_error>([&] { deque.insert(other.begin(), 0); }));
+
+    auto stale = deque.begin();
+    deque.clear();
+    assert(throws<std::logic_error>([&] { *stale; }));
+}
+
+void test_reads_do_not_invalidate() {
+    Deque<int> deque;
+    for (int i = 0; i < 200; i++) deque.push_back(i);
+
+    auto it = deque.begin() + 150;
+    int sum = 0;
+    for (std::size_t k = 0; k < deque.segment_count(); k++) {
+        for (int value : deque.segment(k)) sum += value;
+    }
+    deque[5] = 42;
+    assert(sum == 199 * 200 / 2 && *it == 150);
+}
+
+}  // namespace
+
+int main() {
+    test_bounds();
+    test_iterator_invalidation();
+    test_reads_do_not_invalidate();
+}
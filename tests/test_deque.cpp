@@ -0,0 +1,582 @@
+/* Deterministic unit checks for Deque; the randomized coverage lives in fuzz/deque_fuzz.cpp. */
+
+#undef NDEBUG  // the checks below must survive Release builds
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../src/Deque.hpp"
+#include "../src/DequeParallel.hpp"
+
+namespace {
+
+/*Block policy that throws std::bad_alloc on the `countdown`-th allocation from now; negative never fails*/
+struct FailingBlockAllocator {
+    static inline long countdown = -1;
+
+    static void* allocate(std::size_t bytes) {
+        if (countdown >= 0 && countdown-- == 0) {
+            throw std::bad_alloc();
+        }
+        return ::operator new(bytes);
+    }
+
+    static void deallocate(void* storage, std::size_t) noexcept { ::operator delete(storage); }
+};
+
+void assert_same(Deque<int>& deque, const std::deque<int>& model) {
+    assert(deque.get_size() == model.size());
+    for (std::size_t i = 0; i < model.size(); i++) {
+        assert(deque[i] == model[i]);
+    }
+}
+
+void test_push_pop() {
+    std::vector<int> v = {60, 50, 15, 10, 5, 3, 1, 6, 7, 2, 4, 20, 21, 100};
+    Deque<int> deque;
+    std::deque<int> model;
+
+    for (int value : v) {
+        deque.push_back(value);
+        model.push_back(value);
+    }
+    for (auto it = v.rbegin(); it != v.rend(); ++it) {
+        deque.push_front(*it);
+        model.push_front(*it);
+    }
+    assert_same(deque, model);
+
+    for (int i = 0; i < 3; i++) {
+        deque.pop_front();
+        model.pop_front();
+    }
+    for (int i = 0; i < 5; i++) {
+        deque.pop_back();
+        model.pop_back();
+    }
+    assert_same(deque, model);
+}
+
+void test_block_crossing() {
+    Deque<int> deque;
+    std::deque<int> model;
+
+    for (int i = 0; i < 1000; i++) {
+        deque.push_back(i);
+        model.push_back(i);
+        deque.push_front(-i);
+        model.push_front(-i);
+    }
+    assert_same(deque, model);
+
+    for (int i = 0; i < 1500; i++) {
+        deque.pop_front();
+        model.pop_front();
+    }
+    assert_same(deque, model);
+}
+
+void test_insert_erase() {
+    Deque<int> deque;
+    std::deque<int> model;
+
+    for (int i = 0; i < 10; i++) {
+        deque.push_back(i);
+        model.push_back(i);
+    }
+
+    deque.insert(deque.begin() + 4, 123);
+    model.insert(model.begin() + 4, 123);
+    deque.erase(deque.begin());
+    model.erase(model.begin());
+    deque.erase(deque.begin() + (deque.get_size() - 1));
+    model.erase(model.begin() + (model.size() - 1));
+    assert_same(deque, model);
+}
+
+void test_copy_is_deep() {
+    Deque<int> original;
+    for (int i = 0; i < 200; i++) original.push_back(i);
+
+    Deque<int> copy(original);
+    copy[0] = -1;
+    copy.push_back(999);
+    assert(original[0] == 0);
+    assert(original.get_size() == 200);
+
+    Deque<int> assigned;
+    assigned = original;
+    assigned.pop_front();
+    assert(original.get_size() == 200);
+    assert(assigned.front() == 1);
+}
+
+/* A move allocates nothing: the moved-from deque keeps no map and no block until its next push */
+void test_move_leaves_no_storage() {
+    Deque<std::string> original;
+    for (int i = 0; i < 200; i++) original.push_back(std::to_string(i));
+    std::size_t bytes = original.memory_usage().total();
+
+    Deque<std::string> moved(std::move(original));
+    assert(moved.get_size() == 200 && moved.back() == "199" && moved.memory_usage().total() == bytes);
+    assert(original.empty() && original.memory_usage().total() == 0 && original.segment_count() == 0);
+    original.pop_back();
+    original.clear();
+    original.shrink_to_fit();
+    assert(original.begin() == original.end() && original.linearize().data == nullptr);
+
+    original.push_front("a");                                        // Every kind of push brings the storage back.
+    original.push_back("b");
+    assert(original.front() == "a" && original.back() == "b");
+
+    Deque<std::string> appended(std::move(original));
+    const std::string more[] = {"c", "d"};
+    original.append(more, 2);
+    Deque<std::string> inserted(std::move(original));
+    original.insert(original.begin(), "e");
+    assert(appended.get_size() == 2 && inserted.get_size() == 2 && inserted[1] == "d");
+    assert(original.get_size() == 1 && original[0] == "e");
+
+    Deque<std::string> spliced(std::move(original));
+    spliced.splice_back(std::move(original));                        // Unallocated on either side of a splice.
+    original.splice_back(std::move(spliced));
+    assert(original.get_size() == 1 && spliced.empty());
+    Deque<std::string> tail = spliced.split_at(0);
+    assert(tail.empty() && spliced.empty());
+}
+
+void test_pop_empty_is_noop() {
+    Deque<int> deque;
+    deque.pop_back();
+    deque.pop_front();
+    assert(deque.empty());
+
+    deque.push_back(7);
+    assert(deque.front() == 7 && deque.back() == 7);
+}
+
+/* at() is checked in every build; index == size is the first invalid index */
+void test_at_throws_past_the_end() {
+    Deque<int> deque;
+    for (int i = 0; i < 70; i++) deque.push_back(i);
+    assert(deque.at(69) == 69);
+
+    bool thrown = false;
+    try {
+        deque.at(70);
+    } catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+#ifndef DEQUE_CHECKED
+static_assert(sizeof(Deque<int>::Iterator) == sizeof(void*) + sizeof(std::size_t), "unchecked iterators carry no generation");
+#endif
+
+void test_from_array() {
+    int source[] = {1, 2, 3, 4};
+    Deque<int> deque(source, 4);
+    assert(deque.get_size() == 4);
+    assert(deque.back() == 4);
+}
+
+void test_memory_usage() {
+    Deque<int> deque;
+    for (int i = 0; i < 1000; i++) deque.push_back(i);
+
+    DequeMemoryUsage usage = deque.memory_usage();
+    assert(usage.map_bytes > 0);
+    assert(usage.live_block_bytes >= 1000 * sizeof(int));
+    assert(usage.total() == usage.map_bytes + usage.live_block_bytes + usage.idle_block_bytes);
+
+    for (int i = 0; i < 900; i++) deque.pop_front();
+    assert(deque.memory_usage().idle_block_bytes > 0);
+
+    deque.shrink_to_fit();
+    assert(deque.memory_usage().idle_block_bytes == 0);
+    assert(deque.front() == 900 && deque.back() == 999);
+}
+
+/* The prefetching traversals visit exactly the elements, in order, with the front in the middle of a block */
+void test_scans_visit_every_element() {
+    Deque<int> deque;
+    for (int i = 0; i < 1000; i++) deque.push_back(i);
+    for (int i = 0; i < 37; i++) deque.pop_front();
+
+    int expected = 37;
+    deque.for_each_segment([&](DequeSegment<int*> segment) {
+        for (int value : segment) assert(value == expected++);
+    });
+    assert(expected == 1000);
+
+    expected = 37;
+    for (auto it = deque.begin(); it != deque.end(); ++it) assert(*it == expected++);
+    assert(expected == 1000);
+}
+
+/* A bounded FIFO must reach a steady state instead of growing the map with every block it walks through */
+void test_fifo_footprint_is_bounded() {
+    Deque<int> deque;
+    for (int i = 0; i < 100; i++) deque.push_back(i);
+
+    for (int i = 0; i < 100000; i++) {
+        deque.push_back(i);
+        deque.pop_front();
+    }
+
+    assert(deque.get_size() == 100);
+    assert(deque.memory_usage().total() < 16 * 1024);
+}
+
+/* copy_to, parallel_copy_to and to_vector match the element order for any front offset, on the memcpy, the threaded and the
+ * element-wise path */
+void test_copy_out() {
+    for (int size : {0, 1, 63, 64, 65, 1000}) {
+        Deque<int> deque;
+        for (int i = 0; i < size; i++) deque.push_back(i);
+        for (int i = 0; i < 5; i++) deque.push_front(-1 - i);
+
+        std::vector<int> flat = deque.to_vector();
+        assert(flat.size() == deque.get_size());
+        for (std::size_t i = 0; i < flat.size(); i++) assert(flat[i] == deque[i]);
+    }
+
+    Deque<uint32_t> big;                                             // 24 MiB: split between three threads.
+    for (uint32_t i = 0; i < 6000000; i++) big.push_back(i);
+    big.pop_front();
+    std::vector<uint32_t> flat(big.get_size());
+    parallel_copy_to(big, flat.data(), 3);
+    for (std::size_t i = 0; i < flat.size(); i++) assert(flat[i] == i + 1);
+
+    Deque<std::string> strings;
+    for (int i = 0; i < 200; i++) strings.push_front(std::to_string(i));
+    std::vector<std::string> copied = strings.to_vector();
+    assert(copied.size() == 200 && copied.front() == "199" && copied.back() == "0");
+    assert(strings.front() == "199");                                // Copied, not moved.
+}
+
+void test_linearize() {
+    Deque<std::string> deque;
+    for (int i = 0; i < 40; i++) deque.push_back(std::to_string(i));
+    for (int i = 0; i < 20; i++) deque.push_front(std::to_string(-1 - i));
+    assert(deque.segment_count() == 2);
+
+    DequeSegment<std::string*> flat = deque.linearize();
+    assert(flat.size == deque.get_size() && deque.segment_count() == 1);
+    for (std::size_t i = 0; i < flat.size; i++) assert(flat.data[i] == deque[i]);
+    assert(flat.data[0] == "-20" && flat.data[59] == "39");
+
+    deque.push_back("x");                                            // Still a working deque afterwards.
+    assert(deque.back() == "x" && deque.get_size() == 61);
+
+    Deque<int> full;
+    for (int i = 0; i < 64; i++) full.push_back(i);
+    assert(full.linearize().size == 64);
+    for (int i = 0; i < 64; i++) assert(full[i] == i);
+
+    for (int i = 0; i < 100; i++) full.push_back(i);
+    for (int i = 0; i < 30; i++) full.push_front(-1 - i);
+    DequeSegment<int*> repacked = full.linearize();                  // Bigger than a block: repacked into one larger block.
+    assert(repacked.size == 194 && full.segment_count() == 1 && full.block_size() >= 196);
+    for (int i = 0; i < 194; i++) assert(repacked.data[i] == full[i]);
+    assert(repacked.data[0] == -30 && repacked.data[30] == 0 && repacked.data[193] == 99);
+    for (int i = 0; i < 1000; i++) full.push_front(i), full.push_back(i);
+    assert(full.get_size() == 2194 && full.front() == 999 && full.back() == 999);
+
+    Deque<std::string> strings(DequeBlockSizing::adaptive);
+    for (int i = 0; i < 5000; i++) strings.push_front(std::to_string(i));
+    DequeSegment<std::string*> flat_strings = strings.linearize();
+    assert(flat_strings.size == 5000 && strings.segment_count() == 1);
+    for (int i = 0; i < 5000; i++) assert(flat_strings.data[i] == std::to_string(4999 - i));
+
+    Deque<int> empty;
+    assert(empty.linearize().data == nullptr);
+
+    Deque<int, FailingBlockAllocator> failing;                      // The block cannot be allocated: nothing changes.
+    for (int i = 0; i < 300; i++) failing.push_back(i);
+    FailingBlockAllocator::countdown = 0;
+    assert(failing.linearize().data == nullptr);
+    FailingBlockAllocator::countdown = -1;
+    assert(failing.get_size() == 300 && failing.segment_count() > 1);
+    for (int i = 0; i < 300; i++) assert(failing[i] == i);
+    assert(failing.linearize().size == 300);
+}
+
+/* splice_back / splice_front keep the order for every combination of offsets, relink the blocks when they line up and leave
+ * the other deque empty but usable */
+void test_splice() {
+    for (int front_pad : {0, 1, 17, 63}) {
+        for (int other_pad : {0, 5, 40}) {
+            for (int other_size : {1, 30, 64, 500}) {
+                Deque<int> deque;
+                std::deque<int> model;
+                for (int i = 0; i < 300; i++) deque.push_back(i), model.push_back(i);
+                for (int i = 0; i < front_pad; i++) deque.push_front(-1 - i), model.push_front(-1 - i);
+
+                Deque<int> back;
+                Deque<int> front;
+                for (int i = 0; i < other_size; i++) back.push_back(1000 + i), front.push_back(5000 + i);
+                for (int i = 0; i < other_pad; i++) back.push_front(999 - i), front.push_front(4999 - i);
+                std::deque<int> expected_front(front.begin(), front.end());
+
+                for (int value : back) model.push_back(value);
+                deque.splice_back(std::move(back));
+                model.insert(model.begin(), expected_front.begin(), expected_front.end());
+                deque.splice_front(std::move(front));
+                assert_same(deque, model);
+
+                assert(back.empty() && front.empty());
+                back.push_back(1);
+                front.push_front(2);
+                assert(back.front() == 1 && front.back() == 2);
+            }
+        }
+    }
+
+    Deque<int> left;                                                 // Aligned: the blocks move, the elements stay put.
+    Deque<int> right;
+    for (int i = 0; i < 1000000; i++) left.push_back(i), right.push_back(1000000 + i);
+    left.push_front(-1);
+    left.pop_front();
+    const int* moved = &right[100];
+    std::size_t usage = left.memory_usage().total() + right.memory_usage().total();
+    left.splice_back(std::move(right));
+    assert(left.get_size() == 2000000 && &left[1000100] == moved);
+    assert(left.memory_usage().total() + right.memory_usage().total() <= usage + 2 * 1024 * 1024);
+    for (int i = 0; i < 2000000; i++) assert(left[i] == i);
+
+    Deque<std::string> words;
+    Deque<std::string> more;
+    for (int i = 0; i < 100; i++) words.push_back(std::to_string(i));
+    for (int i = 0; i < 70; i++) more.push_front(std::to_string(-1 - i));
+    words.splice_front(std::move(more));
+    assert(words.get_size() == 170 && words.front() == "-70" && words[69] == "-1" && words.back() == "99");
+
+    Deque<std::string> empty;
+    empty.splice_back(std::move(words));                             // Into an empty deque: a swap.
+    assert(empty.get_size() == 170 && words.empty());
+}
+
+/* rotate matches std::rotate, on the block path (size a multiple of the block) and the element-wise one */
+void test_rotate() {
+    for (int size : {1, 5, 64, 128, 640, 1000}) {
+        for (int pad : {0, 3, 63}) {
+            for (int k : {0, 1, 31, 64, 65, 200, 639, 999, 2001}) {
+                Deque<int> deque;
+                for (int i = 0; i < size; i++) deque.push_back(i);
+                for (int i = 0; i < pad; i++) deque.push_front(-1 - i), deque.pop_back();
+                std::deque<int> model(deque.begin(), deque.end());
+                std::rotate(model.begin(), model.begin() + k % size, model.end());
+                deque.rotate(k);
+                assert_same(deque, model);
+                deque.push_back(7);
+                deque.push_front(8);
+                assert(deque.back() == 7 && deque.front() == 8);
+            }
+        }
+    }
+
+    Deque<std::string> words;
+    for (int i = 0; i < 128; i++) words.push_back(std::to_string(i));
+    words.rotate(100);
+    assert(words.front() == "100" && words[27] == "127" && words[28] == "0" && words.back() == "99");
+}
+
+/* split_at hands the tail over with its blocks, for every offset of the split inside its block */
+void test_split_at() {
+    for (int pad : {0, 1, 40, 63}) {
+        for (int pos : {0, 1, 30, 63, 64, 65, 200, 999, 1000}) {
+            Deque<int> deque;
+            std::deque<int> model;
+            for (int i = 0; i < 1000 - pad; i++) deque.push_back(i), model.push_back(i);
+            for (int i = 0; i < pad; i++) deque.push_front(-1 - i), model.push_front(-1 - i);
+
+            const int* kept = pos + 100 < 1000 ? &deque[pos + 100] : nullptr;
+            Deque<int> tail = deque.split_at(pos);
+            std::deque<int> model_tail(model.begin() + pos, model.end());
+            model.erase(model.begin() + pos, model.end());
+            assert_same(deque, model);
+            assert_same(tail, model_tail);
+            assert(kept == nullptr || &tail[100] == kept);              // Moved by pointer, not copied.
+
+            deque.push_back(1);
+            tail.push_front(2);
+            assert(deque.back() == 1 && tail.front() == 2);
+            tail.pop_front();
+            deque.pop_back();
+            deque.splice_back(std::move(tail));
+            assert(deque.get_size() == 1000);
+        }
+    }
+
+    Deque<std::string> words;
+    for (int i = 0; i < 150; i++) words.push_back(std::to_string(i));
+    Deque<std::string> rest = words.split_at(70);
+    assert(words.get_size() == 70 && words.back() == "69" && rest.front() == "70" && rest.back() == "149");
+
+    bool thrown = false;
+    try {
+        words.split_at(71);
+    } catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+/* Adaptive block sizing: blocks start small, double by repacking as the deque grows and stop at the byte cap, with the
+ * contents intact through every repack and through splices between deques of different block sizes */
+void test_adaptive_blocks() {
+    Deque<int> deque(DequeBlockSizing::adaptive);
+    std::deque<int> model;
+    assert(deque.block_size() == std::size_t(1) << DEQUE_ADAPTIVE_MIN_SHIFT);
+
+    Deque<int> fixed;
+    for (int i = 0; i < 20; i++) deque.push_back(i), fixed.push_back(i), model.push_back(i);
+    assert(deque.memory_usage().total() < fixed.memory_usage().total());
+
+    std::vector<int> values(300);
+    for (int i = 0; i < 300; i++) values[i] = -i;
+    for (int round = 0; round < 400; round++) {
+        deque.push_front(round);
+        model.push_front(round);
+        int& back = deque.emplace_back(round + 1);                    // Valid even when this push repacked.
+        model.push_back(round + 1);
+        assert(back == round + 1 && &back == &deque.back());
+        if (round % 50 == 0) {
+            deque.append(values.data(), values.size());
+            model.insert(model.end(), values.begin(), values.end());
+            deque.prepend(values.data(), values.size());
+            model.insert(model.begin(), values.begin(), values.end());
+            deque.insert(deque.begin() + 7, round);
+            model.insert(model.begin() + 7, round);
+        }
+    }
+    assert(deque.block_size() > std::size_t(1) << DEQUE_ADAPTIVE_MIN_SHIFT);
+    assert_same(deque, model);
+
+    Deque<int> copy(deque);
+    assert(copy.block_size() == deque.block_size());
+    Deque<int> small(DequeBlockSizing::adaptive);
+    for (int i = 0; i < 10; i++) small.push_back(i), model.push_back(i);
+    deque.splice_back(std::move(small));                             // Different block sizes: element-wise.
+    assert_same(deque, model);
+
+    Deque<int> tail = deque.split_at(1000);
+    assert(tail.block_size() == deque.block_size() && tail.get_size() == model.size() - 1000);
+
+    Deque<int> big(DequeBlockSizing::adaptive);
+    for (int i = 0; i < 4000000; i++) big.push_back(i);
+    assert(big.block_size() == DEQUE_ADAPTIVE_MAX_BLOCK_BYTES / sizeof(int));
+    for (int i = 0; i < 4000000; i += 999) assert(big[i] == i);
+
+    Deque<std::string> words(DequeBlockSizing::adaptive);
+    for (int i = 0; i < 5000; i++) words.push_front(std::to_string(i));
+    assert(words.front() == "4999" && words.back() == "0" && words.block_size() > 16);
+}
+
+/* The push that doubles adaptive blocks relocates every element, so pointers taken before it dangle; pushes into fixed blocks
+ * never move elements */
+void test_adaptive_repack_moves_elements() {
+    for (bool back : {true, false}) {
+        Deque<int> deque(DequeBlockSizing::adaptive);
+        std::size_t initial = deque.block_size();
+        deque.push_back(0);
+        const int* first = &deque[0];
+        int pushed = 1;
+        while (deque.block_size() == initial) {
+            int& added = back ? deque.emplace_back(pushed) : deque.emplace_front(pushed);
+            assert(added == pushed);
+            pushed++;
+        }
+        const int* moved = &deque[back ? 0 : deque.get_size() - 1];
+        assert(moved != first && *moved == 0);                        // Repacked into a new block, old one freed.
+        assert(deque.get_size() >= (DEQUE_ADAPTIVE_GROWTH_BLOCKS - 1) * initial);
+        for (std::size_t i = 0; i < deque.get_size(); i++) {
+            assert(deque[i] == static_cast<int>(back ? i : deque.get_size() - 1 - i));
+        }
+    }
+
+    Deque<int> fixed;
+    fixed.push_back(0);
+    const int* first = &fixed[0];
+    for (int i = 1; i < 100000; i++) fixed.push_back(i), fixed.push_front(-i);
+    assert(&fixed[100000 - 1] == first);
+}
+
+/* A push whose block or map allocation throws leaves the deque as it was: the element is neither counted nor leaked, and the
+ * next pushes work. Strings are past the SSO limit, so a leaked or doubly destroyed element shows under ASan */
+void test_failed_allocation_leaves_deque_intact() {
+    auto value = [](std::size_t i) { return std::string(40, 'a') + std::to_string(i); };
+    std::vector<std::string> batch;
+    for (std::size_t i = 0; i < 100; i++) batch.push_back(value(i));
+
+    for (int operation = 0; operation < 4; operation++) {
+        for (long failure = 0; failure < 10; failure++) {
+            Deque<std::string, FailingBlockAllocator> deque;
+            std::deque<std::string> model;
+            FailingBlockAllocator::countdown = failure;
+            bool thrown = false;
+            try {
+                for (std::size_t i = 0; i < 2000; i++) {
+                    if (operation == 0) {
+                        deque.push_back(value(i));
+                        model.push_back(value(i));
+                    } else if (operation == 1) {
+                        deque.push_front(value(i));
+                        model.push_front(value(i));
+                    } else if (operation == 2) {
+                        deque.append(batch.data(), batch.size());
+                        model.insert(model.end(), batch.begin(), batch.end());
+                    } else {
+                        deque.insert(deque.begin() + deque.get_size() / 2, value(i));
+                        model.insert(model.begin() + model.size() / 2, value(i));
+                    }
+                }
+            } catch (const std::bad_alloc&) {
+                thrown = true;
+            }
+            FailingBlockAllocator::countdown = -1;
+            assert(thrown);
+
+            if (operation == 2) {                                    // append commits block by block.
+                assert(deque.get_size() >= model.size() && deque.get_size() <= model.size() + batch.size());
+                model.insert(model.end(), batch.begin(), batch.begin() + (deque.get_size() - model.size()));
+            }
+            assert(deque.get_size() == model.size());
+            for (std::size_t i = 0; i < model.size(); i++) assert(deque[i] == model[i]);
+            for (std::size_t i = 0; i < 200; i++) deque.push_back(value(i)), deque.push_front(value(i));
+            assert(deque.get_size() == model.size() + 400 && deque.back() == value(199));
+        }
+    }
+}
+
+}  // namespace
+
+int main() {
+    test_push_pop();
+    test_block_crossing();
+    test_insert_erase();
+    test_copy_is_deep();
+    test_move_leaves_no_storage();
+    test_pop_empty_is_noop();
+    test_at_throws_past_the_end();
+    test_from_array();
+    test_memory_usage();
+    test_fifo_footprint_is_bounded();
+    test_scans_visit_every_element();
+    test_copy_out();
+    test_linearize();
+    test_splice();
+    test_rotate();
+    test_split_at();
+    test_adaptive_blocks();
+    test_adaptive_repack_moves_elements();
+    test_failed_allocation_leaves_deque_intact();
+}
@@ -0,0 +1,146 @@
+/* Deque<bool>: bit-packed storage against a std::deque<bool> model, word-level pushes and pops across word boundaries, count()
+ * and the memory footprint. */
+
+#undef NDEBUG
+
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <stdexcept>
+
+#include "../src/Deque.hpp"
+
+namespace {
+
+void check_equal(const Deque<bool>& deque, const std::deque<bool>& model) {
+    assert(deque.get_size() == model.size());
+    std::size_t set = 0;
+    for (std::size_t i = 0; i < model.size(); i++) {
+        assert(deque[i] == model[i]);
+        set += model[i];
+    }
+    assert(deque.count() == set);
+}
+
+void test_single_flags() {
+    Deque<bool> deque;
+    std::deque<bool> model;
+    assert(deque.empty() && deque.count() == 0);
+
+    for (int i = 0; i < 1000; i++) {
+        deque.push_back(i % 3 == 0);
+        model.push_back(i % 3 == 0);
+        deque.push_front(i % 5 == 0);
+        model.push_front(i % 5 == 0);
+    }
+    check_equal(deque, model);
+    assert(deque.front() == model.front() && deque.back() == model.back());
+
+    deque.set(17, true);
+    model[17] = true;
+    deque.set(1500, false);
+    model[1500] = false;
+    check_equal(deque, model);
+
+    while (!model.empty()) {
+        deque.pop_front();
+        model.pop_front();
+        if (!model.empty()) {
+            deque.pop_back();
+            model.pop_back();
+        }
+    }
+    check_equal(deque, model);
+    deque.pop_back();                                                // Popping an empty deque is a no-op, as for Deque<T>.
+    assert(deque.empty());
+
+    bool thrown = false;
+    try {
+        deque.at(0);
+    } catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+void test_bits_random() {
+    std::mt19937_64 generator(66);
+    Deque<bool> deque;
+    std::deque<bool> model;
+
+    for (int step = 0; step < 20000; step++) {
+        uint64_t bits = generator();
+        std::size_t count = generator() % 65;
+        switch (generator() % 4) {
+            case 0:
+                deque.push_back_bits(bits, count);
+                for (std::size_t i = 0; i < count; i++) model.push_back((bits >> i) & 1);
+                break;
+            case 1:
+                deque.push_front_bits(bits, count);
+                for (std::size_t i = count; i-- > 0;) model.push_front((bits >> i) & 1);
+                break;
+            case 2: {
+                count = std::min(count, model.size());
+                uint64_t popped = deque.pop_front_bits(count);
+                for (std::size_t i = 0; i < count; i++) {
+                    assert(((popped >> i) & 1) == model.front());
+                    model.pop_front();
+                }
+                assert(count == 64 || popped >> count == 0);
+                break;
+            }
+            default: {
+                count = std::min(count, model.size());
+                uint64_t popped = deque.pop_back_bits(count);
+                for (std::size_t i = count; i-- > 0;) {
+                    assert(((popped >> i) & 1) == model.back());
+                    model.pop_back();
+                }
+                break;
+            }
+        }
+        if (step % 500 == 0) check_equal(deque, model);
+    }
+    check_equal(deque, model);
+
+    Deque<bool> copy(deque);
+    Deque<bool> moved(std::move(deque));
+    check_equal(copy, model);
+    check_equal(moved, model);
+    assert(deque.empty() && deque.memory_usage().total() == 0);
+    deque.push_front(true);
+    assert(deque.get_size() == 1 && deque.front());
+}
+
+void test_sliding_window_memory() {
+    const std::size_t window = 100000;
+    Deque<bool> flags;
+    Deque<char> bytes;
+    std::size_t successes = 0;
+    for (std::size_t i = 0; i < 3 * window; i++) {
+        bool success = i % 7 != 0;
+        flags.push_back(success);
+        bytes.push_back(success);
+        successes += success;
+        if (flags.get_size() > window) {
+            successes -= flags.front();
+            flags.pop_front();
+            bytes.pop_front();
+        }
+    }
+    assert(flags.count() == successes);
+
+    flags.shrink_to_fit();
+    bytes.shrink_to_fit();
+    assert(flags.memory_usage().live_block_bytes * 7 < bytes.memory_usage().live_block_bytes);
+}
+
+}  // namespace
+
+int main() {
+    test_single_flags();
+    test_bits_random();
+    test_sliding_window_memory();
+}
@@ -0,0 +1,185 @@
+/* BFS distances computed through Frontier (single pops, batched pops, parallel levels) and 0-1 BFS, against std::deque. */
+
+#undef NDEBUG
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+
+#include "../src/Frontier.hpp"
+
+namespace {
+
+const uint32_t unreached = std::numeric_limits<uint32_t>::max();
+
+struct Graph {
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> targets;
+    std::vector<uint8_t> weights;                                    // 0 or 1, used by the 0-1 BFS
+
+    uint32_t node_count() const { return static_cast<uint32_t>(this->offsets.size() - 1); }
+};
+
+Graph make_graph(uint32_t nodes, uint32_t degree) {
+    std::mt19937 generator(13);
+    Graph graph;
+    graph.offsets.push_back(0);
+    for (uint32_t node = 0; node < nodes; node++) {
+        uint32_t edges = generator() % (2 * degree);
+        for (uint32_t e = 0; e < edges; e++) {
+            graph.targets.push_back(generator() % nodes);
+            graph.weights.push_back(generator() % 2);
+        }
+        graph.offsets.push_back(static_cast<uint32_t>(graph.targets.size()));
+    }
+    return graph;
+}
+
+std::vector<uint32_t> reference_bfs(const Graph& graph) {
+    std::vector<uint32_t> distance(graph.node_count(), unreached);
+    std::deque<uint32_t> queue = {0};
+    distance[0] = 0;
+    while (!queue.empty()) {
+        uint32_t node = queue.front();
+        queue.pop_front();
+        for (uint32_t e = graph.offsets[node]; e < graph.offsets[node + 1]; e++) {
+            uint32_t target = graph.targets[e];
+            if (distance[target] == unreached) {
+                distance[target] = distance[node] + 1;
+                queue.push_back(target);
+            }
+        }
+    }
+    return distance;
+}
+
+std::vector<uint32_t> frontier_bfs_batched(const Graph& graph) {
+    std::vector<uint32_t> distance(graph.node_count(), unreached);
+    Frontier<uint32_t> frontier;
+    frontier.push(0);
+    distance[0] = 0;
+
+    std::vector<uint32_t> batch(256);
+    std::vector<uint32_t> discovered;
+    while (!frontier.empty()) {
+        std::size_t taken = frontier.pop_batch(batch.data(), batch.size());
+        for (std::size_t i = 0; i < taken; i++) {
+            uint32_t node = batch[i];
+            discovered.clear();
+            for (uint32_t e = graph.offsets[node]; e < graph.offsets[node + 1]; e++) {
+                uint32_t target = graph.targets[e];
+                if (distance[target] == unreached) {
+                    distance[target] = distance[node] + 1;
+                    discovered.push_back(target);
+                }
+            }
+            frontier.push_span(discovered.data(), discovered.size());
+        }
+    }
+    return distance;
+}
+
+std::vector<uint32_t> frontier_bfs_parallel(const Graph& graph, std::size_t threads) {
+    std::unique_ptr<std::atomic<uint32_t>[]> distance(new std::atomic<uint32_t>[graph.node_count()]);
+    for (uint32_t node = 0; node < graph.node_count(); node++) distance[node] = unreached;
+
+    Frontier<uint32_t> frontier;
+    frontier.push(0);
+    distance[0] = 0;
+
+    for (uint32_t level = 1; !frontier.empty(); level++) {
+        frontier.expand_level(threads, [&](uint32_t node, std::vector<uint32_t>& next) {
+            for (uint32_t e = graph.offsets[node]; e < graph.offsets[node + 1]; e++) {
+                uint32_t expected = unreached;
+                if (distance[graph.targets[e]].compare_exchange_strong(expected, level)) {
+                    next.push_back(graph.targets[e]);
+                }
+            }
+        });
+    }
+
+    std::vector<uint32_t> result(graph.node_count());
+    for (uint32_t node = 0; node < graph.node_count(); node++) result[node] = distance[node];
+    return result;
+}
+
+uint32_t take(std::deque<uint32_t>& queue) {
+    uint32_t node = queue.front();
+    queue.pop_front();
+    return node;
+}
+
+uint32_t take(Frontier<uint32_t>& frontier) { return frontier.pop(); }
+
+void put_back(std::deque<uint32_t>& queue, uint32_t node) { queue.push_back(node); }
+
+void put_back(Frontier<uint32_t>& frontier, uint32_t node) { frontier.push(node); }
+
+/* 0-weight edges go to the front, 1-weight edges to the back */
+template <typename Queue>
+std::vector<uint32_t> zero_one_bfs(const Graph& graph) {
+    std::vector<uint32_t> distance(graph.node_count(), unreached);
+    Queue queue;
+    put_back(queue, 0);
+    distance[0] = 0;
+    while (!queue.empty()) {
+        uint32_t node = take(queue);
+        for (uint32_t e = graph.offsets[node]; e < graph.offsets[node + 1]; e++) {
+            uint32_t target = graph.targets[e];
+            uint32_t candidate = distance[node] + graph.weights[e];
+            if (candidate < distance[target]) {
+                distance[target] = candidate;
+                if (graph.weights[e] == 0) {
+                    queue.push_front(target);
+                } else {
+                    put_back(queue, target);
+                }
+            }
+        }
+    }
+    return distance;
+}
+
+/*An expand() that throws, on the calling thread or a worker, reaches the caller after the join and leaves the level in place*/
+void test_expand_exception() {
+    for (uint32_t failing : {uint32_t(10), uint32_t(30000)}) {
+        Frontier<uint32_t> frontier;
+        for (uint32_t node = 0; node < 40000; node++) frontier.push(node);
+        bool thrown = false;
+        try {
+            frontier.expand_level(4, [failing](uint32_t node, std::vector<uint32_t>& next) {
+                if (node == failing) throw std::runtime_error("expand failed");
+                next.push_back(node);
+            });
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown && frontier.get_size() == 40000 && frontier.pop() == 0);
+    }
+}
+
+}  // namespace
+
+int main() {
+    Graph graph = make_graph(200000, 4);
+    std::vector<uint32_t> expected = reference_bfs(graph);
+
+    assert(frontier_bfs_batched(graph) == expected);
+    assert(frontier_bfs_parallel(graph, 1) == expected);
+    assert(frontier_bfs_parallel(graph, 4) == expected);
+    assert(zero_one_bfs<Frontier<uint32_t>>(graph) == zero_one_bfs<std::deque<uint32_t>>(graph));
+    test_expand_exception();
+
+    Frontier<uint32_t> frontier;
+    uint32_t span[] = {1, 2, 3};
+    frontier.push_span_front(span, 3);
+    frontier.push_front(0);
+    assert(frontier.pop() == 0 && frontier.pop() == 1);
+    frontier.clear();
+    assert(frontier.empty());
+}
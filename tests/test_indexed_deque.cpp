@@ -0,0 +1,108 @@
+/* IndexedDeque::range_sum against a naive rescan while the deque slides through many blocks. */
+
+#undef NDEBUG
+
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <random>
+
+#include "../src/IndexedDeque.hpp"
+
+namespace {
+
+int64_t naive_sum(const std::deque<int>& model, std::size_t first, std::size_t last) {
+    int64_t sum = 0;
+    for (std::size_t i = first; i < last; i++) sum += model[i];
+    return sum;
+}
+
+void check_ranges(const IndexedDeque<int, int64_t>& indexed, const std::deque<int>& model, std::mt19937& generator) {
+    assert(indexed.get_size() == model.size());
+    assert(indexed.total() == naive_sum(model, 0, model.size()));
+    for (int probe = 0; probe < 20; probe++) {
+        std::size_t a = generator() % (model.size() + 1);
+        std::size_t b = generator() % (model.size() + 1);
+        if (a > b) std::swap(a, b);
+        assert(indexed.range_sum(a, b) == naive_sum(model, a, b));
+    }
+}
+
+void test_sliding() {
+    IndexedDeque<int, int64_t> indexed;
+    std::deque<int> model;
+    std::mt19937 generator(11);
+
+    for (int step = 0; step < 50000; step++) {
+        int value = static_cast<int>(generator() % 2001) - 1000;
+        switch (generator() % 5) {
+            case 0:
+            case 1:
+                indexed.push_back(value);
+                model.push_back(value);
+                break;
+            case 2:
+                indexed.push_front(value);
+                model.push_front(value);
+                break;
+            case 3:
+                indexed.pop_front();
+                if (!model.empty()) model.pop_front();
+                break;
+            case 4:
+                indexed.pop_back();
+                if (!model.empty()) model.pop_back();
+                break;
+        }
+        if (step % 97 == 0) {
+            check_ranges(indexed, model, generator);
+        }
+    }
+}
+
+void test_drain_and_refill() {
+    IndexedDeque<int, int64_t> indexed;
+    for (int i = 0; i < 1000; i++) indexed.push_back(i);
+    for (int i = 0; i < 1000; i++) indexed.pop_front();
+    assert(indexed.empty());
+    assert(indexed.total() == 0);
+
+    for (int i = 1; i <= 100; i++) indexed.push_front(i);
+    assert(indexed.total() == 5050);
+    assert(indexed.range_sum(0, 10) == 100 + 99 + 98 + 97 + 96 + 95 + 94 + 93 + 92 + 91);
+
+    indexed.rebuild();
+    assert(indexed.total() == 5050);
+    assert(indexed.range_sum(90, 100) == 55);
+}
+
+/* A rolling window with the default Sum = int: far more than INT_MAX passes through, while every window sum fits. The
+ * boundaries wrap instead of overflowing, which the ubsan build would report */
+void test_rolling_sum_outlives_int() {
+    const int value = 1000000;
+    const std::size_t window = 1500;
+    IndexedDeque<int> indexed;
+    for (std::size_t i = 0; i < window; i++) indexed.push_back(value);
+
+    for (int step = 0; step < 20000; step++) {                       // 2e10 pushed at the back, 1.5e9 in the window.
+        indexed.pop_front();
+        indexed.push_back(value);
+    }
+    assert(indexed.total() == static_cast<int>(window) * value);
+    assert(indexed.range_sum(100, 1400) == 1300 * value);
+
+    for (int step = 0; step < 20000; step++) {                       // And the same toward the front.
+        indexed.pop_back();
+        indexed.push_front(-value);
+    }
+    assert(indexed.total() == static_cast<int>(window) * -value);
+    assert(indexed.range_sum(1, 1500) == 1499 * -value);
+}
+
+}  // namespace
+
+int main() {
+    test_sliding();
+    test_drain_and_refill();
+    test_rolling_sum_outlives_int();
+}
@@ -0,0 +1,126 @@
+/* Deque as a standard range: iterator concepts, const iteration, C++17 algorithms on the random access paths, range pipelines
+ * and the segments() view. Built as C++20. */
+
+#undef NDEBUG
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <vector>
+
+#include "../src/Deque.hpp"
+
+namespace {
+
+using Ints = Deque<int>;
+
+static_assert(std::random_access_iterator<Ints::iterator>);
+static_assert(std::random_access_iterator<Ints::const_iterator>);
+static_assert(std::sized_sentinel_for<Ints::iterator, Ints::iterator>);
+static_assert(std::ranges::random_access_range<Ints>);
+static_assert(std::ranges::random_access_range<const Ints>);
+static_assert(std::ranges::sized_range<Ints>);
+static_assert(std::ranges::viewable_range<Ints&>);
+static_assert(std::same_as<std::ranges::range_reference_t<const Ints>, const int&>);
+static_assert(std::is_convertible_v<Ints::iterator, Ints::const_iterator>);
+static_assert(!std::is_convertible_v<Ints::const_iterator, Ints::iterator>);
+
+static_assert(std::ranges::random_access_range<decltype(std::declval<Ints&>().segments())>);
+static_assert(std::ranges::sized_range<decltype(std::declval<Ints&>().segments())>);
+static_assert(std::ranges::view<decltype(std::declval<Ints&>().segments())>);
+static_assert(std::ranges::contiguous_range<DequeSegment<int*>>);
+static_assert(std::ranges::view<DequeSegment<const int*>>);
+
+Ints make(int count, int first = 0) {
+    Ints deque;
+    for (int i = 0; i < count; i++) deque.push_back(first + i);
+    return deque;
+}
+
+void test_iterator_arithmetic() {
+    Ints deque = make(300);
+    auto first = deque.begin();
+    auto last = deque.end();
+    assert(last - first == 300 && std::ranges::size(deque) == 300);
+    assert(first[150] == 150 && *(2 + first) == 2 && *(last - 1) == 299);
+    assert(first < last && last > first && first <= first && last >= last);
+
+    auto it = first;
+    assert(*it++ == 0 && *it == 1);
+    assert(*it-- == 1 && it == first);
+    it += 70;
+    it -= 5;
+    assert(*it == 65);
+
+    Ints::const_iterator constant = it;                              // iterator -> const_iterator
+    assert(constant == it && it == constant && *constant == 65);
+    assert(std::distance(deque.cbegin(), constant) == 65);
+}
+
+void test_algorithms() {
+    Ints deque = make(1000);
+    std::reverse(deque.begin(), deque.end());
+    assert(deque.front() == 999 && deque.back() == 0);
+    std::sort(deque.begin(), deque.end());
+    assert(std::is_sorted(deque.begin(), deque.end()));
+    assert(*std::lower_bound(deque.begin(), deque.end(), 640) == 640);
+
+    const Ints& view = deque;
+    assert(std::accumulate(view.begin(), view.end(), 0L) == 999L * 1000 / 2);
+    assert(std::ranges::find(view, 321) - view.begin() == 321);
+
+    std::ranges::sort(deque, std::ranges::greater());
+    assert(deque.front() == 999);
+}
+
+void test_pipelines() {
+    Ints deque = make(500, -100);
+    std::vector<int> squares;
+    for (int value : deque | std::views::filter([](int v) { return v % 7 == 0; })
+                           | std::views::transform([](int v) { return v * v; })) {
+        squares.push_back(value);
+    }
+    std::vector<int> expected;
+    for (int v = -100; v < 400; v++) {
+        if (v % 7 == 0) expected.push_back(v * v);
+    }
+    assert(squares == expected);
+
+    auto tail = deque | std::views::drop(450) | std::views::reverse;
+    assert(std::ranges::size(tail) == 50 && *tail.begin() == 399);
+}
+
+void test_segment_view() {
+    Ints deque = make(1000);
+    deque.push_front(-1);
+
+    std::size_t count = 0;
+    std::size_t total = 0;
+    for (auto segment : deque.segments()) {
+        assert(segment.size > 0 && segment.size <= 64);
+        total += segment.size;
+        count++;
+    }
+    assert(count == deque.segment_count() && total == deque.get_size());
+    assert(std::ranges::size(deque.segments()) == deque.segment_count());
+    assert(deque.segments()[1].data == &deque[deque.segment_offset(1)]);
+
+    std::vector<int> joined;
+    const Ints& constant = deque;
+    for (int value : constant.segments() | std::views::join) joined.push_back(value);
+    assert(std::ranges::equal(joined, constant));
+
+    for (auto segment : deque.segments()) std::ranges::fill(segment, 7);
+    assert(std::ranges::count(deque, 7) == 1001);
+}
+
+}  // namespace
+
+int main() {
+    test_iterator_arithmetic();
+    test_algorithms();
+    test_pipelines();
+    test_segment_view();
+}
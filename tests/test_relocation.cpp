@@ -0,0 +1,223 @@
+/* Element lifetime and the trivially-relocatable fast path: every constructed element is destroyed exactly once, and insert/erase
+ * give the same sequence whether elements move by memmove (unique_ptr), one by one (Counted, std::string) or by copy (ThrowingCopy).
+ * A copy that throws propagates out of every operation and leaves a deque that can still be read and destroyed. */
+
+#undef NDEBUG
+
+#include <cassert>
+#include <deque>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../src/Deque.hpp"
+
+namespace {
+
+int live_objects = 0;
+
+/* Not trivially relocatable: the self pointer must be fixed up by the move constructor */
+struct Counted {
+    int value;
+    const Counted* self;
+
+    explicit Counted(int _value) : value(_value), self(this) { live_objects++; }
+    Counted(const Counted& other) : value(other.value), self(this) { live_objects++; }
+    Counted(Counted&& other) noexcept : value(other.value), self(this) { live_objects++; }
+    Counted& operator=(const Counted& other) {
+        this->value = other.value;
+        return *this;
+    }
+    ~Counted() {
+        assert(this->self == this);
+        live_objects--;
+    }
+};
+
+int copies_left = -1;                                               // Copies until one throws; negative never throws.
+
+/* Only a copy constructor, which allocates and may throw, so relocating one copies it */
+struct ThrowingCopy {
+    std::vector<int> payload;
+
+    explicit ThrowingCopy(int value) : payload(3, value) {}
+    ThrowingCopy(const ThrowingCopy& other) : payload(other.payload) {
+        if (copies_left >= 0 && copies_left-- == 0) {
+            throw std::runtime_error("copy failed");
+        }
+    }
+    ThrowingCopy& operator=(const ThrowingCopy&) = default;
+
+    int value() const { return this->payload[0]; }
+};
+
+static_assert(!std::is_nothrow_move_constructible<ThrowingCopy>::value, "moves fall back to the throwing copy");
+
+static_assert(is_trivially_relocatable_v<int>, "trivially copyable types qualify");
+static_assert(is_trivially_relocatable_v<std::unique_ptr<int>>, "unique_ptr opts in");
+static_assert(!is_trivially_relocatable_v<std::string>, "libstdc++ strings point into themselves");
+static_assert(!is_trivially_relocatable_v<Counted>, "user types have to opt in");
+
+template <typename Deque_, typename Make, typename Read>
+void random_edits(Deque_& deque, Make make, Read read) {
+    std::deque<int> model;
+    std::mt19937 generator(21);
+
+    for (int step = 0; step < 6000; step++) {
+        int value = step;
+        std::size_t index = generator() % (model.size() + 1);
+        switch (generator() % 6) {
+            case 0:
+                deque.push_back(make(value));
+                model.push_back(value);
+                break;
+            case 1:
+                deque.push_front(make(value));
+                model.push_front(value);
+                break;
+            case 2:
+            case 3:
+                deque.insert(deque.begin() + index, make(value));
+                model.insert(model.begin() + index, value);
+                break;
+            case 4:
+                if (index < model.size()) {
+                    deque.erase(deque.begin() + index);
+                    model.erase(model.begin() + index);
+                }
+                break;
+            case 5:
+                deque.pop_front();
+                if (!model.empty()) model.pop_front();
+                break;
+        }
+    }
+
+    assert(deque.get_size() == model.size());
+    for (std::size_t i = 0; i < model.size(); i++) {
+        assert(read(deque[i]) == model[i]);
+    }
+}
+
+void test_counted_lifetime() {
+    {
+        Deque<Counted> deque;
+        random_edits(deque, [](int v) { return Counted(v); }, [](const Counted& c) { return c.value; });
+        assert(live_objects == static_cast<int>(deque.get_size()));
+
+        Deque<Counted> copy(deque);
+        assert(live_objects == 2 * static_cast<int>(deque.get_size()));
+        copy.clear();
+        assert(live_objects == static_cast<int>(deque.get_size()));
+    }
+    assert(live_objects == 0);
+}
+
+void test_unique_ptr_memmove_path() {
+    Deque<std::unique_ptr<int>> deque;
+    random_edits(deque, [](int v) { return std::make_unique<int>(v); }, [](const std::unique_ptr<int>& p) { return *p; });
+
+    deque.emplace_back(new int(-1));
+    assert(*deque.back() == -1);
+}
+
+void test_string_element_path() {
+    Deque<std::string> deque;
+    random_edits(
+        deque, [](int v) { return (v % 2 ? "a long string that does not fit the small buffer " : "") + std::to_string(v); },
+        [](const std::string& s) { return std::stoi(s.substr(s.find_last_of(' ') + 1)); });
+}
+
+void test_throwing_copy_path() {
+    Deque<ThrowingCopy> deque;
+    random_edits(deque, [](int v) { return ThrowingCopy(v); }, [](const ThrowingCopy& c) { return c.value(); });
+}
+
+/*Deque of values [0, size) with the adaptive sizing, so pushes also repack*/
+Deque<ThrowingCopy> counting(int size) {
+    Deque<ThrowingCopy> deque(DequeBlockSizing::adaptive);
+    for (int i = 0; i < size; i++) deque.emplace_back(i);
+    return deque;
+}
+
+/*Every element still holds a value from the original range*/
+void assert_readable(const Deque<ThrowingCopy>& deque, int limit) {
+    for (std::size_t i = 0; i < deque.get_size(); i++) {
+        assert(deque[i].payload.size() == 3 && deque[i].value() >= -1 && deque[i].value() < limit);
+    }
+}
+
+void test_throwing_copy_unwinds() {
+    const int size = 700;
+    for (int failure = 0; failure < 40; failure++) {
+        for (int operation = 0; operation < 7; operation++) {
+            Deque<ThrowingCopy> deque = counting(size);
+            Deque<ThrowingCopy> other = counting(size);
+            other.pop_front();
+            copies_left = failure * 17;
+            bool thrown = false;
+            try {
+                switch (operation) {
+                    case 0:
+                        deque.insert(deque.begin() + 300, ThrowingCopy(-1));
+                        break;
+                    case 1:
+                        deque.erase(deque.begin() + 300);
+                        break;
+                    case 2:
+                        deque.splice_back(std::move(other));
+                        break;
+                    case 3:
+                        deque.rotate(350);
+                        break;
+                    case 4:
+                        deque.split_at(100);
+                        break;
+                    case 5:
+                        for (int i = 0; i < 20000; i++) deque.emplace_back(i % size);
+                        break;
+                    case 6:
+                        deque.linearize();
+                        break;
+                }
+            } catch (const std::runtime_error&) {
+                thrown = true;
+            }
+            copies_left = -1;
+            assert_readable(deque, size);
+            assert_readable(other, size);
+
+            if (thrown && operation == 0) {
+                assert(deque.get_size() == size || deque.get_size() == size + 1);
+            }
+            if (operation == 2 || operation == 3) {                  // Whole chunks move or stay, nothing is lost.
+                assert(deque.get_size() + other.get_size() == 2 * size - 1);
+            }
+            if (!thrown && operation == 0) {
+                assert(deque.get_size() == size + 1 && deque[300].value() == -1 && deque[301].value() == 300);
+            }
+            if (!thrown && operation == 3) {
+                for (int i = 0; i < size; i++) assert(deque[i].value() == (i + 350) % size);
+            }
+            if (operation == 6) {                                    // Copies first, so a throw leaves every element in place.
+                assert(thrown || deque.segment_count() == 1);
+                for (int i = 0; i < size; i++) assert(deque[i].value() == i);
+            }
+            deque.emplace_back(0);
+            deque.emplace_front(0);
+        }
+    }
+}
+
+}  // namespace
+
+int main() {
+    test_counted_lifetime();
+    test_unique_ptr_memmove_path();
+    test_string_element_path();
+    test_throwing_copy_path();
+    test_throwing_copy_unwinds();
+}
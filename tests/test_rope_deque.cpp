@@ -0,0 +1,124 @@
+/* RopeDeque against std::deque under random middle edits. Small blocks force frequent splits and merges; std::string elements
+ * make lifetime mistakes visible to the sanitizer builds. */
+
+#undef NDEBUG
+
+#include <cassert>
+#include <deque>
+#include <random>
+#include <string>
+
+#include "../src/RopeDeque.hpp"
+
+namespace {
+
+template <typename Rope, typename Model>
+void assert_same(const Rope& rope, const Model& model) {
+    assert(rope.get_size() == model.size());
+    std::size_t index = 0;
+    for (std::size_t k = 0; k < rope.segment_count(); k++) {
+        auto segment = rope.segment(k);
+        assert(segment.size > 0);
+        for (const auto& value : segment) {
+            assert(value == model[index++]);
+        }
+    }
+    for (std::size_t i = 0; i < model.size(); i += 7) {
+        assert(rope[i] == model[i]);
+    }
+}
+
+void test_random_edits() {
+    RopeDeque<std::string, 16 * sizeof(std::string)> rope;
+    std::deque<std::string> model;
+    std::mt19937 generator(3);
+
+    for (int step = 0; step < 30000; step++) {
+        std::string value = "value-" + std::to_string(step);
+        switch (generator() % 6) {
+            case 0:
+                rope.push_back(value);
+                model.push_back(value);
+                break;
+            case 1:
+                rope.push_front(value);
+                model.push_front(value);
+                break;
+            case 2: {
+                std::size_t index = generator() % (model.size() + 1);
+                rope.insert(index, value);
+                model.insert(model.begin() + index, value);
+                break;
+            }
+            case 3:
+                if (!model.empty()) {
+                    std::size_t index = generator() % model.size();
+                    rope.erase(index);
+                    model.erase(model.begin() + index);
+                }
+                break;
+            case 4:
+                rope.pop_front();
+                if (!model.empty()) model.pop_front();
+                break;
+            case 5:
+                rope.pop_back();
+                if (!model.empty()) model.pop_back();
+                break;
+        }
+        if (step % 500 == 0) {
+            assert_same(rope, model);
+        }
+    }
+    assert_same(rope, model);
+
+    RopeDeque<std::string, 16 * sizeof(std::string)> copy(rope);
+    assert_same(copy, model);
+}
+
+void test_blocks_stay_dense() {
+    RopeDeque<int> rope;
+    for (int i = 0; i < 100000; i++) rope.push_back(i);
+    for (int i = 0; i < 90000; i++) rope.erase(rope.get_size() / 2);
+
+    assert(rope.get_size() == 10000);
+    assert(rope.block_count() <= 4 * (10000 / RopeDeque<int>::block_capacity + 1));
+    assert(rope.front() == 0 && rope.back() == 99999);
+}
+
+/*Front blocks come and go through the slack before the first block; the index must follow without a rebuild*/
+void test_front_edits() {
+    RopeDeque<std::string, 16 * sizeof(std::string)> rope;
+    std::deque<std::string> model;
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 5000; i++) {
+            rope.push_front(std::to_string(i));
+            model.push_front(std::to_string(i));
+        }
+        assert_same(rope, model);
+        for (int i = 0; i < 3000; i++) {
+            rope.pop_front();
+            model.pop_front();
+            rope.push_back(std::to_string(-i));
+            model.push_back(std::to_string(-i));
+        }
+        rope.insert(rope.get_size() / 3, "middle");
+        model.insert(model.begin() + model.size() / 3, "middle");
+        assert_same(rope, model);
+    }
+    while (!model.empty()) {
+        rope.pop_front();
+        model.pop_front();
+    }
+    assert(rope.empty() && rope.block_count() == 0);
+    rope.push_front("again");
+    assert(rope.get_size() == 1 && rope.front() == "again" && rope[0] == "again");
+}
+
+}  // namespace
+
+int main() {
+    test_random_edits();
+    test_blocks_stay_dense();
+    test_front_edits();
+}
@@ -0,0 +1,214 @@
+/* ShmDeque: FIFO order through wraparound, full/empty edges, a second mapping of the same segment, and two producer processes
+ * feeding one consumer. */
+
+#undef NDEBUG
+
+#include <cassert>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../src/ShmDeque.hpp"
+
+namespace {
+
+std::string segment_name(const char* test) { return "/own_deque_test_" + std::to_string(::getpid()) + "_" + test; }
+
+void test_fifo_wraparound() {
+    std::string name = segment_name("fifo");
+    auto deque = ShmDeque<uint64_t>::create(name, 100);
+    ShmDeque<uint64_t>::unlink(name);
+    assert(deque.capacity() == 128);                                 // Whole blocks.
+    assert(deque.empty());
+
+    uint64_t value = 0;
+    assert(!deque.try_pop(value));
+
+    uint64_t next_push = 0;
+    uint64_t next_pop = 0;
+    for (int round = 0; round < 50; round++) {                       // Keep 0..127 elements in flight across many laps.
+        while (deque.try_push(next_push)) next_push++;
+        assert(deque.get_size() == deque.capacity());
+        for (int i = 0; i < 37 + round; i++) {
+            assert(deque.try_pop(value));
+            assert(value == next_pop++);
+        }
+    }
+    while (deque.try_pop(value)) assert(value == next_pop++);
+    assert(next_pop == next_push && deque.empty());
+}
+
+void test_spans_and_batches() {
+    std::string name = segment_name("span");
+    auto deque = ShmDeque<uint32_t>::create(name, 256);
+    ShmDeque<uint32_t>::unlink(name);
+
+    std::vector<uint32_t> input(1000);
+    for (std::size_t i = 0; i < input.size(); i++) input[i] = static_cast<uint32_t>(i * 7);
+    std::vector<uint32_t> output;
+
+    std::size_t pushed = 0;
+    uint32_t batch[100];
+    while (output.size() < input.size()) {
+        pushed += deque.push_span(input.data() + pushed, std::min<std::size_t>(90, input.size() - pushed));
+        std::size_t popped = deque.pop_batch(batch, 100);
+        output.insert(output.end(), batch, batch + popped);
+    }
+    assert(output == input);
+    assert(deque.push_span(input.data(), input.size()) == deque.capacity());
+}
+
+void test_second_mapping() {
+    std::string name = segment_name("open");
+    auto producer = ShmDeque<int64_t>::create(name, 64);
+    auto consumer = ShmDeque<int64_t>::open(name);
+    ShmDeque<int64_t>::unlink(name);
+
+    for (int64_t i = 0; i < 64; i++) assert(producer.try_push(-i));
+    assert(!producer.try_push(1));
+    int64_t value = 0;
+    for (int64_t i = 0; i < 64; i++) {
+        assert(consumer.try_pop(value) && value == -i);
+    }
+    assert(producer.empty());
+    assert(producer.try_push(1));                                    // The producer sees the space the consumer freed.
+
+    bool thrown = false;
+    try {
+        ShmDeque<int64_t>::open(name);
+    } catch (const std::system_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    ShmDeque<int64_t> moved(std::move(consumer));
+    assert(moved.try_pop(value) && value == 1);
+}
+
+void test_open_checks_layout() {
+    std::string name = segment_name("layout");
+    auto deque = ShmDeque<uint64_t>::create(name, 64);
+
+    bool thrown = false;
+    try {
+        ShmDeque<uint64_t, ShmProducers::multiple>::open(name);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    thrown = false;
+    try {
+        ShmDeque<uint64_t>::create(name, 64);
+    } catch (const std::system_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    ShmDeque<uint64_t>::unlink(name);
+}
+
+/*A segment whose creator has not ftruncate()d it or stored the magic yet is "not ready", which callers can retry on*/
+void test_open_before_ready() {
+    std::string name = segment_name("ready");
+    int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);  // What create() has done right after shm_open.
+    assert(fd >= 0);
+
+    for (int stage = 0; stage < 2; stage++) {
+        bool not_ready = false;
+        try {
+            ShmDeque<uint64_t>::open(name);
+        } catch (const ShmDequeNotReady&) {
+            not_ready = true;
+        }
+        assert(not_ready);
+        assert(::ftruncate(fd, 1 << 16) == 0);                       // Sized, but the header is still zero.
+    }
+    ::close(fd);
+    ShmDeque<uint64_t>::unlink(name);
+}
+
+struct alignas(256) Wide {
+    uint64_t value;
+};
+
+/*Cells stricter than a cache line: the blocks are aligned to the cell, so every element access is aligned*/
+template <ShmProducers Producers>
+void test_overaligned_cells() {
+    std::string name = segment_name(Producers == ShmProducers::single ? "wide" : "wide_mpsc");
+    auto deque = ShmDeque<Wide, Producers>::create(name, 520);      // 9 blocks: the map ends off a 256-byte boundary.
+    ShmDeque<Wide, Producers>::unlink(name);
+
+    Wide value{};
+    for (uint64_t round = 0; round < 3; round++) {
+        for (uint64_t i = 0; i < deque.capacity(); i++) assert(deque.try_push(Wide{round * 1000 + i}));
+        for (uint64_t i = 0; i < deque.capacity(); i++) assert(deque.try_pop(value) && value.value == round * 1000 + i);
+    }
+}
+
+struct Message {
+    uint32_t producer;
+    uint32_t sequence;
+};
+
+void test_two_producer_processes() {
+    const uint32_t producers = 2;
+    const uint32_t per_producer = 20000;
+
+    std::string name = segment_name("mpsc");
+    auto deque = ShmDeque<Message, ShmProducers::multiple>::create(name, 64);
+
+    std::vector<pid_t> children;
+    for (uint32_t p = 0; p < producers; p++) {
+        pid_t pid = ::fork();
+        assert(pid >= 0);
+        if (pid == 0) {
+            auto queue = ShmDeque<Message, ShmProducers::multiple>::open(name);
+            for (uint32_t i = 0; i < per_producer; i++) {
+                while (!queue.try_push(Message{p, i})) ::sched_yield();
+            }
+            ::_exit(0);
+        }
+        children.push_back(pid);
+    }
+
+    std::vector<uint32_t> expected(producers, 0);
+    Message message{};
+    for (uint32_t received = 0; received < producers * per_producer;) {
+        if (!deque.try_pop(message)) {
+            ::sched_yield();
+            continue;
+        }
+        assert(message.producer < producers);
+        assert(message.sequence == expected[message.producer]);      // Per-producer order survives the interleaving.
+        expected[message.producer]++;
+        received++;
+    }
+    for (pid_t pid : children) {
+        int status = 0;
+        assert(::waitpid(pid, &status, 0) == pid);
+        assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+    assert(deque.empty());
+    ShmDeque<Message, ShmProducers::multiple>::unlink(name);
+}
+
+}  // namespace
+
+int main() {
+    test_fifo_wraparound();
+    test_spans_and_batches();
+    test_second_mapping();
+    test_open_checks_layout();
+    test_open_before_ready();
+    test_overaligned_cells<ShmProducers::single>();
+    test_overaligned_cells<ShmProducers::multiple>();
+    test_two_producer_processes();
+}
@@ -0,0 +1,76 @@
+/* SortedDeque against std::multiset on a mostly-ordered stream with late arrivals. */
+
+#undef NDEBUG
+
+#include <cassert>
+#include <iterator>
+#include <random>
+#include <set>
+
+#include "../src/SortedDeque.hpp"
+
+namespace {
+
+void assert_same(const SortedDeque<int>& sorted, const std::multiset<int>& model) {
+    assert(sorted.get_size() == model.size());
+    std::size_t index = 0;
+    for (int value : model) {
+        assert(sorted[index++] == value);
+    }
+}
+
+void test_against_multiset() {
+    SortedDeque<int> sorted;
+    std::multiset<int> model;
+    std::mt19937 generator(7);
+
+    for (int t = 0; t < 20000; t++) {
+        int value = t - static_cast<int>(generator() % 200);       // up to 200 ticks late
+        sorted.insert(value);
+        model.insert(value);
+
+        if (t % 3 == 0) {
+            sorted.pop_front();
+            model.erase(model.begin());
+        }
+        if (t % 1000 == 0) {
+            assert_same(sorted, model);
+        }
+    }
+    assert_same(sorted, model);
+
+    for (int probe = 0; probe < 20000; probe += 37) {
+        std::size_t lower = static_cast<std::size_t>(std::distance(model.begin(), model.lower_bound(probe)));
+        std::size_t upper = static_cast<std::size_t>(std::distance(model.begin(), model.upper_bound(probe)));
+        assert(sorted.lower_bound(probe) == lower);
+        assert(sorted.upper_bound(probe) == upper);
+        assert(sorted.count(probe) == model.count(probe));
+        assert(sorted.contains(probe) == (model.count(probe) > 0));
+    }
+}
+
+void test_erase_value() {
+    SortedDeque<int, std::greater<int>> sorted;
+    for (int value : {5, 1, 9, 5, 3}) sorted.insert(value);
+
+    assert(sorted.front() == 9 && sorted.back() == 1);
+    assert(sorted.erase_value(5));
+    assert(sorted.count(5) == 1);
+    assert(!sorted.erase_value(4));
+    assert(sorted.get_size() == 4);
+}
+
+void test_empty() {
+    SortedDeque<int> sorted;
+    assert(sorted.lower_bound(3) == 0);
+    assert(sorted.upper_bound(3) == 0);
+    assert(!sorted.contains(3));
+}
+
+}  // namespace
+
+int main() {
+    test_against_multiset();
+    test_erase_value();
+    test_empty();
+}
@@ -0,0 +1,136 @@
+/* StringDeque: contents against a std::deque<std::string> model under random pushes and pops at both ends, arenas following the
+ * blocks, and a steady log-line queue that stops allocating. */
+
+#undef NDEBUG
+
+#include <cassert>
+#include <deque>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include "../src/StringDeque.hpp"
+
+namespace {
+
+std::size_t allocations = 0;
+
+/*Heap policy that counts its calls*/
+struct CountingAllocator {
+    static void* allocate(std::size_t bytes) {
+        allocations++;
+        return ::operator new(bytes);
+    }
+    static void deallocate(void* storage, std::size_t) noexcept { ::operator delete(storage); }
+};
+
+using CountingStringDeque = BasicStringDeque<CountingAllocator>;
+
+std::string make_string(std::mt19937& generator) {
+    std::size_t length = generator() % 8 == 0 ? generator() % 5000 : generator() % 40;   // Some outgrow the first arena.
+    std::string text(length, ' ');
+    for (auto& c : text) c = static_cast<char>('a' + generator() % 26);
+    return text;
+}
+
+void check_equal(const StringDeque& deque, const std::deque<std::string>& model) {
+    assert(deque.get_size() == model.size());
+    for (std::size_t i = 0; i < model.size(); i++) assert(deque[i] == model[i]);
+
+    std::size_t index = 0;
+    deque.for_each([&](std::string_view text) { assert(text == model[index++]); });
+    assert(index == model.size());
+}
+
+void test_random_operations() {
+    std::mt19937 generator(68);
+    StringDeque deque;
+    std::deque<std::string> model;
+
+    for (int step = 0; step < 30000; step++) {
+        switch (generator() % 5) {
+            case 0:
+            case 1: {
+                std::string text = make_string(generator);
+                deque.push_back(text);
+                model.push_back(text);
+                break;
+            }
+            case 2: {
+                std::string text = make_string(generator);
+                deque.push_front(text);
+                model.push_front(text);
+                break;
+            }
+            case 3:
+                deque.pop_front();
+                if (!model.empty()) model.pop_front();
+                break;
+            default:
+                deque.pop_back();
+                if (!model.empty()) model.pop_back();
+                break;
+        }
+        if (step % 1000 == 0) check_equal(deque, model);
+    }
+    check_equal(deque, model);
+
+    StringDeque copy(deque);
+    StringDeque moved(std::move(deque));
+    check_equal(copy, model);
+    check_equal(moved, model);
+    assert(deque.empty() && deque.memory_usage().total() == 0);
+    deque.push_back("again");
+    assert(deque.get_size() == 1 && deque.front() == "again");
+
+    copy.clear();
+    assert(copy.empty() && copy.memory_usage().live_block_bytes < moved.memory_usage().live_block_bytes);
+
+    bool thrown = false;
+    try {
+        copy.at(0);
+    } catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+void test_arenas_follow_blocks() {
+    StringDeque deque;
+    std::size_t initial = deque.memory_usage().total();
+    deque.push_back("");                                             // Empty strings need no bytes at all.
+    assert(deque.front().empty() && deque.memory_usage().total() == initial);
+    deque.pop_back();
+
+    for (int i = 0; i < 1000; i++) deque.push_back(std::to_string(i));
+    std::size_t full = deque.memory_usage().live_block_bytes;
+    for (int i = 0; i < 990; i++) deque.pop_front();
+    assert(deque.memory_usage().live_block_bytes < full / 4);        // Drained blocks gave their arenas back.
+    assert(deque.front() == "990" && deque.back() == "999");
+}
+
+void test_log_queue_allocations() {
+    const std::size_t window = 4096;
+    CountingStringDeque queue;
+    std::string line = "2026-10-17T12:00:00Z INFO request served in 12ms path=/api/v1/items id=";
+
+    for (std::size_t i = 0; i < 4 * window; i++) {                  // Warm up: blocks, map and spares reach their size.
+        queue.push_back(line + std::to_string(i));
+        if (queue.get_size() > window) queue.pop_front();
+    }
+    std::size_t before = allocations;
+    for (std::size_t i = 0; i < 100000; i++) {
+        queue.push_back(line + std::to_string(i));
+        if (queue.get_size() > window) queue.pop_front();
+    }
+    assert((allocations - before) * 1000 <= 2 * 100000);           // At most two allocations per thousand lines.
+    assert(queue.back() == line + "99999");
+}
+
+}  // namespace
+
+int main() {
+    test_random_operations();
+    test_arenas_follow_blocks();
+    test_log_queue_allocations();
+}
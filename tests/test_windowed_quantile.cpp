@@ -0,0 +1,125 @@
+/* WindowedQuantile against sorting a copy of the window, with many duplicates and both fixed-size and time-based expiry. */
+
+#undef NDEBUG
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <deque>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "../src/WindowedQuantile.hpp"
+
+namespace {
+
+template <typename Cmp>
+void assert_same(const WindowedQuantile<int, Cmp>& sketch, const std::deque<int>& window, Cmp cmp) {
+    std::vector<int> sorted(window.begin(), window.end());
+    std::sort(sorted.begin(), sorted.end(), cmp);
+    assert(sketch.get_size() == sorted.size());
+    for (std::size_t rank = 0; rank < sorted.size(); rank++) {
+        assert(sketch.select(rank) == sorted[rank]);
+    }
+    for (double q : {0.0, 0.01, 0.5, 0.9, 0.99, 1.0}) {
+        std::size_t rank = static_cast<std::size_t>(std::ceil(q * static_cast<double>(sorted.size())));
+        assert(sketch.quantile(q) == sorted[rank == 0 ? 0 : rank - 1]);
+    }
+    for (int probe : {-1, 0, 17, 50, 99, 100}) {
+        auto below = std::lower_bound(sorted.begin(), sorted.end(), probe, cmp);
+        assert(sketch.count_less(probe) == static_cast<std::size_t>(below - sorted.begin()));
+    }
+}
+
+void test_against_sorted_window() {
+    for (std::size_t window : {1, 2, 7, 300}) {
+        WindowedQuantile<int> sketch(window);
+        std::deque<int> model;
+        std::mt19937 generator(static_cast<unsigned>(window));
+
+        for (int t = 0; t < 5000; t++) {
+            int value = static_cast<int>(generator() % 100);        // Plenty of equal samples.
+            sketch.push(value);
+            model.push_back(value);
+            if (model.size() > window) {
+                model.pop_front();
+            }
+            assert(sketch.oldest() == model.front() && sketch.newest() == value);
+            if (t % 97 == 0 || window < 10) {
+                assert_same(sketch, model, std::less<int>());
+            }
+        }
+    }
+}
+
+void test_time_based_expiry() {
+    WindowedQuantile<int, std::greater<int>> sketch(1000, std::greater<int>());
+    std::deque<int> model;
+    std::mt19937 generator(75);
+
+    for (int t = 0; t < 20000; t++) {
+        int value = static_cast<int>(generator() % 100);
+        sketch.push(value);
+        model.push_back(value);
+        std::size_t keep = 100 + generator() % 400;                 // Variable-length window, drained from the front.
+        while (model.size() > keep) {
+            sketch.pop_oldest();
+            model.pop_front();
+        }
+        if (t % 211 == 0) {
+            assert_same(sketch, model, std::greater<int>());
+        }
+    }
+
+    while (!model.empty()) {
+        sketch.pop_oldest();
+        model.pop_front();
+    }
+    assert(sketch.empty() && sketch.count_less(5) == 0);
+    sketch.push(3);
+    assert(sketch.quantile(0.5) == 3);
+}
+
+void test_errors() {
+    WindowedQuantile<int> sketch(4);
+    bool thrown = false;
+    try {
+        sketch.quantile(0.5);
+    } catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    for (int value : {4, 1, 3, 2, 5}) sketch.push(value);
+    assert(sketch.get_size() == 4 && sketch.quantile(0) == 1 && sketch.quantile(1) == 5);
+
+    thrown = false;
+    try {
+        sketch.select(4);
+    } catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    sketch.clear();
+    assert(sketch.empty());
+    sketch.push(9);
+    assert(sketch.select(0) == 9);
+
+    thrown = false;
+    try {
+        WindowedQuantile<int> none(0);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+}  // namespace
+
+int main() {
+    test_against_sorted_window();
+    test_time_based_expiry();
+    test_errors();
+}
@@ -0,0 +1,40 @@
+#!/bin/sh
+# Code size and compile time of a translation unit that instantiates Deque for many element types, for the headers at a git
+# revision (default HEAD) against the working tree. Shows what the type-erased DequeCore saves per instantiated type.
+#   tools/core_size.sh [baseline-rev] [types]
+set -eu
+
+SOURCE_DIR=$(cd "$(dirname "$0")/.." && pwd)
+REV=${1:-HEAD}
+TYPES=${2:-80}
+CXX=${CXX:-g++}
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+mkdir -p "$WORK/baseline"
+git -C "$SOURCE_DIR" archive "$REV" src | tar -x -C "$WORK/baseline"
+
+# Element sizes cycle through 4..64 bytes; every type gets the common operations of a queue.
+{
+    echo '#include "Deque.hpp"'
+    i=0
+    while [ "$i" -lt "$TYPES" ]; do
+        echo "struct E$i { int bytes[$((i % 16 + 1))]; };"
+        echo "int use$i(Deque<E$i>& d, E$i e) { d.push_back(e); d.push_front(e); d.insert(d.begin() + d.get_size() / 2, e);"
+        echo "    d.erase(d.begin() + 1); d.pop_back(); d.pop_front(); Deque<E$i> copy(d); return copy[0].bytes[0] + d.back().bytes[0]; }"
+        i=$((i + 1))
+    done
+} > "$WORK/instances.cpp"
+
+measure() {
+    start=$(date +%s.%N)
+    $CXX -std=c++17 -O2 -I"$1" -c "$WORK/instances.cpp" -o "$WORK/$2.o"
+    stop=$(date +%s.%N)
+    text=$(size "$WORK/$2.o" | awk 'NR == 2 { print $1 }')
+    awk -v name="$2" -v text="$text" -v start="$start" -v stop="$stop" 'BEGIN { printf "%-10s %12s %10.2f\n", name, text, stop - start }'
+}
+
+printf '%d instantiated element types, %s -O2\n' "$TYPES" "$CXX"
+printf '%-10s %12s %10s\n' headers "text bytes" "compile s"
+measure "$WORK/baseline/src" "$REV"
+measure "$SOURCE_DIR/src" worktree
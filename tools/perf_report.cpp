@@ -0,0 +1,326 @@
+/* Compares two runs of `bench_scenarios --json` (see tools/perf_track.sh) benchmark by benchmark, on the Deque samples:
+ *
+ *   - change of the median time per operation, current against baseline;
+ *   - a 95% bootstrap confidence interval of that ratio of medians (fixed seed, so a report is reproducible);
+ *   - the one-sided Mann-Whitney U p-value that current runs are slower (normal approximation with tie correction).
+ *
+ * A benchmark is a regression when its median is more than --threshold slower, the p-value is below --alpha and the whole
+ * interval lies above 1; improvements are reported the same way in the other direction. The exit status is 1 when there
+ * is at least one regression, so the tool can gate a commit.
+ *
+ *   perf_report BASELINE.json CURRENT.json [--alpha 0.05] [--threshold 0.05] [--container Deque] */
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+/*=================================================================^JSON^=================================================================*/
+
+/* Just enough JSON for the benchmark documents: objects, arrays, strings without escapes beyond \" and \\, numbers,
+ * true/false/null. */
+struct Value {
+    enum Kind { null, boolean, number, string, array, object } kind = null;
+    double number_value = 0;
+    std::string string_value;
+    std::vector<Value> items;
+    std::map<std::string, Value> members;
+
+    const Value& operator[](const std::string& key) const {
+        auto it = this->members.find(key);
+        if (it == this->members.end()) {
+            throw std::runtime_error("perf_report: missing key \"" + key + "\"");
+        }
+        return it->second;
+    }
+};
+
+class Parser {
+public:
+    explicit Parser(const std::string& _text) : text(_text) {}
+
+    Value parse() {
+        Value value = this->parse_value();
+        this->skip_space();
+        if (this->at != this->text.size()) {
+            this->fail("trailing characters");
+        }
+        return value;
+    }
+
+private:
+    const std::string& text;
+    std::size_t at = 0;
+
+    [[noreturn]] void fail(const char* what) const {
+        throw std::runtime_error(std::string("perf_report: bad JSON at offset ") + std::to_string(this->at) + ": " + what);
+    }
+
+    void skip_space() {
+        while (this->at < this->text.size() && std::isspace(static_cast<unsigned char>(this->text[this->at]))) {
+            this->at++;
+        }
+    }
+
+    bool consume(char c) {
+        this->skip_space();
+        if (this->at < this->text.size() && this->text[this->at] == c) {
+            this->at++;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(char c) {
+        if (!this->consume(c)) {
+            this->fail("unexpected character");
+        }
+    }
+
+    std::string parse_string() {
+        this->expect('"');
+        std::string result;
+        while (this->at < this->text.size() && this->text[this->at] != '"') {
+            if (this->text[this->at] == '\\') {
+                this->at++;
+            }
+            result += this->text[this->at++];
+        }
+        this->expect('"');
+        return result;
+    }
+
+    Value parse_value() {
+        Value value;
+        this->skip_space();
+        if (this->at >= this->text.size()) {
+            this->fail("unexpected end");
+        }
+        char c = this->text[this->at];
+        if (c == '{') {
+            value.kind = Value::object;
+            this->at++;
+            if (!this->consume('}')) {
+                do {
+                    std::string key = this->parse_string();
+                    this->expect(':');
+                    value.members[key] = this->parse_value();
+                } while (this->consume(','));
+                this->expect('}');
+            }
+        } else if (c == '[') {
+            value.kind = Value::array;
+            this->at++;
+            if (!this->consume(']')) {
+                do {
+                    value.items.push_back(this->parse_value());
+                } while (this->consume(','));
+                this->expect(']');
+            }
+        } else if (c == '"') {
+            value.kind = Value::string;
+            value.string_value = this->parse_string();
+        } else if (this->text.compare(this->at, 4, "true") == 0 || this->text.compare(this->at, 5, "false") == 0) {
+            value.kind = Value::boolean;
+            value.number_value = c == 't';
+            this->at += c == 't' ? 4 : 5;
+        } else if (this->text.compare(this->at, 4, "null") == 0) {
+            this->at += 4;
+        } else {
+            char* end = nullptr;
+            value.kind = Value::number;
+            value.number_value = std::strtod(this->text.c_str() + this->at, &end);
+            if (end == this->text.c_str() + this->at) {
+                this->fail("expected a value");
+            }
+            this->at = static_cast<std::size_t>(end - this->text.c_str());
+        }
+        return value;
+    }
+};
+
+/*Samples per benchmark name for one container*/
+std::map<std::string, std::vector<double>> load(const char* path, const std::string& container) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error(std::string("perf_report: cannot open ") + path);
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string text = buffer.str();
+    Value document = Parser(text).parse();
+
+    std::map<std::string, std::vector<double>> runs;
+    for (const Value& result : document["results"].items) {
+        if (result["container"].string_value != container) {
+            continue;
+        }
+        std::vector<double>& samples = runs[result["name"].string_value];
+        for (const Value& sample : result["samples"].items) {
+            samples.push_back(sample.number_value);
+        }
+    }
+    return runs;
+}
+
+/*==============================================================^STATISTICS^==============================================================*/
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    std::size_t n = values.size();
+    return n % 2 == 1 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+}
+
+/*One-sided Mann-Whitney U: probability of a U at least this large if `current` were not slower than `baseline`*/
+double mann_whitney_slower(const std::vector<double>& baseline, const std::vector<double>& current) {
+    struct Ranked {
+        double value;
+        bool is_current;
+    };
+    std::vector<Ranked> all;
+    for (double value : baseline) all.push_back({value, false});
+    for (double value : current) all.push_back({value, true});
+    std::sort(all.begin(), all.end(), [](const Ranked& a, const Ranked& b) { return a.value < b.value; });
+
+    double n1 = static_cast<double>(current.size());
+    double n2 = static_cast<double>(baseline.size());
+    double n = n1 + n2;
+    double rank_sum = 0;
+    double ties = 0;                                                 // sum of t^3 - t over groups of equal values.
+    for (std::size_t i = 0; i < all.size();) {
+        std::size_t j = i;
+        while (j < all.size() && all[j].value == all[i].value) j++;
+        double rank = (static_cast<double>(i + 1) + static_cast<double>(j)) / 2;   // Mid-rank of the group.
+        for (std::size_t k = i; k < j; k++) {
+            if (all[k].is_current) rank_sum += rank;
+        }
+        double t = static_cast<double>(j - i);
+        ties += t * t * t - t;
+        i = j;
+    }
+
+    double u = rank_sum - n1 * (n1 + 1) / 2;                         // Pairs where current is slower.
+    double mean = n1 * n2 / 2;
+    double variance = n1 * n2 / 12 * ((n + 1) - ties / (n * (n - 1)));
+    if (variance <= 0) {
+        return 1;
+    }
+    double z = (u - mean - 0.5) / std::sqrt(variance);               // Continuity correction.
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+/*95% percentile bootstrap interval of median(current) / median(baseline)*/
+std::pair<double, double> bootstrap_ratio(const std::vector<double>& baseline, const std::vector<double>& current) {
+    const std::size_t resamples = 4000;
+    std::mt19937 generator(74);
+    std::vector<double> ratios(resamples);
+    std::vector<double> a(baseline.size());
+    std::vector<double> b(current.size());
+    for (double& ratio : ratios) {
+        for (double& value : a) value = baseline[generator() % baseline.size()];
+        for (double& value : b) value = current[generator() % current.size()];
+        ratio = median(b) / median(a);
+    }
+    std::sort(ratios.begin(), ratios.end());
+    return {ratios[resamples * 25 / 1000], ratios[resamples * 975 / 1000]};
+}
+
+/*================================================================^REPORT^================================================================*/
+
+struct Options {
+    const char* baseline = nullptr;
+    const char* current = nullptr;
+    double alpha = 0.05;
+    double threshold = 0.05;
+    std::string container = "Deque";
+};
+
+Options parse_options(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--alpha") == 0 && has_value) {
+            options.alpha = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--threshold") == 0 && has_value) {
+            options.threshold = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--container") == 0 && has_value) {
+            options.container = argv[++i];
+        } else if (options.baseline == nullptr) {
+            options.baseline = argv[i];
+        } else if (options.current == nullptr) {
+            options.current = argv[i];
+        } else {
+            options.baseline = nullptr;
+            break;
+        }
+    }
+    if (options.baseline == nullptr || options.current == nullptr) {
+        std::fprintf(stderr, "usage: %s BASELINE.json CURRENT.json [--alpha A] [--threshold T] [--container NAME]\n", argv[0]);
+        std::exit(2);
+    }
+    return options;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options = parse_options(argc, argv);
+    std::map<std::string, std::vector<double>> baseline;
+    std::map<std::string, std::vector<double>> current;
+    try {
+        baseline = load(options.baseline, options.container);
+        current = load(options.current, options.container);
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "%s\n", error.what());
+        return 2;
+    }
+
+    std::printf("%s: %s -> %s (alpha %.3g, threshold %.1f%%)\n", options.container.c_str(), options.baseline, options.current,
+                options.alpha, options.threshold * 100);
+    std::printf("%-20s %12s %12s %9s %21s %9s  %s\n", "benchmark", "base ns/op", "ns/op", "change", "95% interval", "p", "verdict");
+
+    int regressions = 0;
+    for (const auto& [name, before] : baseline) {
+        auto found = current.find(name);
+        if (found == current.end() || before.size() < 2 || found->second.size() < 2) {
+            std::printf("%-20s %12s\n", name.c_str(), "(not comparable)");
+            continue;
+        }
+        const std::vector<double>& after = found->second;
+        double ratio = median(after) / median(before);
+        auto [low, high] = bootstrap_ratio(before, after);
+        double slower = mann_whitney_slower(before, after);
+        double faster = mann_whitney_slower(after, before);
+
+        const char* verdict = "";
+        if (ratio > 1 + options.threshold && slower < options.alpha && low > 1) {
+            verdict = "REGRESSION";
+            regressions++;
+        } else if (ratio < 1 - options.threshold && faster < options.alpha && high < 1) {
+            verdict = "faster";
+        }
+        std::printf("%-20s %12.3f %12.3f %+8.1f%% [%+7.1f%%, %+7.1f%%] %9.4f  %s\n", name.c_str(), median(before), median(after),
+                    (ratio - 1) * 100, (low - 1) * 100, (high - 1) * 100, std::min(slower, faster), verdict);
+    }
+    for (const auto& entry : current) {
+        if (baseline.find(entry.first) == baseline.end()) {
+            std::printf("%-20s %12s\n", entry.first.c_str(), "(new)");
+        }
+    }
+
+    if (regressions > 0) {
+        std::printf("%d regression%s\n", regressions, regressions == 1 ? "" : "s");
+    }
+    return regressions > 0 ? 1 : 0;
+}
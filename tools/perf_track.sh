@@ -0,0 +1,65 @@
+#!/bin/sh
+# Benchmark history per commit and regression checks against a baseline, all local and offline.
+#   tools/perf_track.sh record [build-dir]            run bench_scenarios --json and store it as perf-history/<commit>.json
+#   tools/perf_track.sh compare BASE [CURRENT]         compare two stored runs, given as revisions or JSON files
+#                                                     (CURRENT defaults to HEAD); exits 1 on a significant regression
+#   tools/perf_track.sh list                           stored runs, oldest first
+# Environment: DEQUE_PERF_DIR (history directory), REPETITIONS (runs per benchmark, default 11), PERF_REPORT_ARGS (passed to
+# perf_report, e.g. "--alpha 0.01 --threshold 0.1"). Compare runs recorded on the same machine and build settings.
+set -eu
+
+SOURCE_DIR=$(cd "$(dirname "$0")/.." && pwd)
+HISTORY=${DEQUE_PERF_DIR:-"$SOURCE_DIR/perf-history"}
+BUILD_DIR="$SOURCE_DIR/build/perf"
+
+build() {
+    cmake -S "$SOURCE_DIR" -B "$BUILD_DIR" -DCMAKE_BUILD_TYPE=Release -DDEQUE_BUILD_TESTS=OFF -DDEQUE_BUILD_FUZZERS=OFF >/dev/null
+    cmake --build "$BUILD_DIR" -j --target bench_scenarios perf_report >/dev/null
+}
+
+# Stored run for a revision or a path; uncommitted changes are recorded as <commit>-dirty.
+resolve() {
+    if [ -f "$1" ]; then
+        echo "$1"
+        return
+    fi
+    commit=$(git -C "$SOURCE_DIR" rev-parse --short=12 "$1")
+    if [ "$1" = HEAD ] && [ -n "$(git -C "$SOURCE_DIR" status --porcelain --untracked-files=no)" ]; then
+        commit="$commit-dirty"
+    fi
+    if [ ! -f "$HISTORY/$commit.json" ]; then
+        echo "no stored run for $1 ($HISTORY/$commit.json); check it out and run: $0 record" >&2
+        exit 2
+    fi
+    echo "$HISTORY/$commit.json"
+}
+
+case ${1:-} in
+    record)
+        BUILD_DIR=${2:-$BUILD_DIR}
+        build
+        mkdir -p "$HISTORY"
+        commit=$(git -C "$SOURCE_DIR" rev-parse --short=12 HEAD)
+        if [ -n "$(git -C "$SOURCE_DIR" status --porcelain --untracked-files=no)" ]; then
+            commit="$commit-dirty"
+        fi
+        "$BUILD_DIR/bench_scenarios" --json --repetitions "${REPETITIONS:-11}" > "$HISTORY/$commit.json.tmp"
+        mv "$HISTORY/$commit.json.tmp" "$HISTORY/$commit.json"
+        echo "stored $HISTORY/$commit.json"
+        ;;
+    compare)
+        [ $# -ge 2 ] || { echo "usage: $0 compare BASE [CURRENT]" >&2; exit 2; }
+        base=$(resolve "$2")
+        current=$(resolve "${3:-HEAD}")
+        build
+        # shellcheck disable=SC2086
+        "$BUILD_DIR/perf_report" "$base" "$current" ${PERF_REPORT_ARGS:-}
+        ;;
+    list)
+        ls -tr "$HISTORY" 2>/dev/null | sed -n 's/\.json$//p'
+        ;;
+    *)
+        sed -n '2,8p' "$0" | sed 's/^# \{0,1\}//'
+        exit 2
+        ;;
+esac
@@ -0,0 +1,20 @@
+#!/bin/sh
+# Two-stage profile-guided build: instrument, train on the benchmark suite, rebuild with the profiles.
+# Both stages use the same build directory because gcc looks profiles up by object path.
+set -eu
+
+SOURCE_DIR=$(cd "$(dirname "$0")/.." && pwd)
+BUILD_DIR=${1:-"$SOURCE_DIR/build/pgo"}
+PROFILE_DIR="$BUILD_DIR/pgo-profiles"
+
+rm -rf "$PROFILE_DIR"
+cmake -S "$SOURCE_DIR" -B "$BUILD_DIR" -DCMAKE_BUILD_TYPE=Release -DDEQUE_PGO=GENERATE -DDEQUE_PGO_DIR="$PROFILE_DIR"
+cmake --build "$BUILD_DIR" -j --target pgo-train                   # Builds just the training benchmarks, then runs them.
+
+if command -v llvm-profdata >/dev/null 2>&1 && ls "$PROFILE_DIR"/*.profraw >/dev/null 2>&1; then
+    llvm-profdata merge -output="$PROFILE_DIR/default.profdata" "$PROFILE_DIR"/*.profraw
+fi
+
+cmake -S "$SOURCE_DIR" -B "$BUILD_DIR" -DDEQUE_PGO=USE -DDEQUE_ENABLE_LTO=ON
+cmake --build "$BUILD_DIR" -j
+echo "PGO build ready in $BUILD_DIR"